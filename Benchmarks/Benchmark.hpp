@@ -0,0 +1,29 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+/// Number of timed runs, the fastest one is reported.
+static const int BENCHMARK_REPEATS = 5;
+
+/// Run func BENCHMARK_REPEATS times and return the fastest run in nanoseconds per operation.
+template <typename Func>
+double MeasureNs(size_t operations, Func&& func)
+{
+    double best = 0.0;
+    for (int i = 0; i < BENCHMARK_REPEATS; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        double ns = elapsed.count() / static_cast<double>(operations);
+        best = i == 0 ? ns : std::min(best, ns);
+    }
+    return best;
+}
+
+inline void PrintResult(const char* name, double ns)
+{
+    std::printf("%-32s %8.2f ns/op\n", name, ns);
+}
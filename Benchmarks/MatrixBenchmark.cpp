@@ -0,0 +1,96 @@
+#include <random>
+#include <vector>
+
+#include "Math/Matrix.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Pt;
+
+static const size_t NUM_MATRICES = 10000;
+static const int NUM_PASSES = 100;
+
+/// Column-major product written out element by element, the baseline for the operators.
+static Matrix4 ScalarMultiply(const Matrix4& lhs, const Matrix4& rhs)
+{
+    Matrix4 result;
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; ++k)
+                sum += lhs.data[k][row] * rhs.data[column][k];
+            result.data[column][row] = sum;
+        }
+    }
+    return result;
+}
+
+int main()
+{
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<Matrix4> matrices(NUM_MATRICES);
+    std::vector<Vector4> vectors(NUM_MATRICES);
+    for (size_t i = 0; i < NUM_MATRICES; ++i)
+    {
+        for (int column = 0; column < 4; ++column)
+        {
+            for (int row = 0; row < 4; ++row)
+                matrices[i].data[column][row] = distribution(random);
+            vectors[i].data[column] = distribution(random);
+        }
+    }
+
+    std::vector<Matrix4> matrixResults(NUM_MATRICES);
+    std::vector<Vector4> vectorResults(NUM_MATRICES);
+    const size_t operations = NUM_MATRICES * NUM_PASSES;
+
+    PrintResult("Matrix4 * Matrix4", MeasureNs(operations, [&]() {
+        for (int pass = 0; pass < NUM_PASSES; ++pass)
+        {
+            size_t j = pass % NUM_MATRICES;
+            for (size_t i = 0; i < NUM_MATRICES; ++i)
+            {
+                if (++j == NUM_MATRICES)
+                    j = 0;
+                matrixResults[i] = matrices[i] * matrices[j];
+            }
+        }
+    }));
+
+    PrintResult("Matrix4 * Matrix4 (reference)", MeasureNs(operations, [&]() {
+        for (int pass = 0; pass < NUM_PASSES; ++pass)
+        {
+            size_t j = pass % NUM_MATRICES;
+            for (size_t i = 0; i < NUM_MATRICES; ++i)
+            {
+                if (++j == NUM_MATRICES)
+                    j = 0;
+                matrixResults[i] = ScalarMultiply(matrices[i], matrices[j]);
+            }
+        }
+    }));
+
+    PrintResult("Matrix4 * Vector4", MeasureNs(operations, [&]() {
+        for (int pass = 0; pass < NUM_PASSES; ++pass)
+        {
+            size_t j = pass % NUM_MATRICES;
+            for (size_t i = 0; i < NUM_MATRICES; ++i)
+            {
+                if (++j == NUM_MATRICES)
+                    j = 0;
+                vectorResults[i] = matrices[i] * vectors[j];
+            }
+        }
+    }));
+
+    // Use the results so the loops are not optimized away.
+    float checksum = 0.0f;
+    for (size_t i = 0; i < NUM_MATRICES; ++i)
+        checksum += matrixResults[i].data[0][0] + vectorResults[i].x;
+    std::printf("checksum %g\n", checksum);
+    return 0;
+}
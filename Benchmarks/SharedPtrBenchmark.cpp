@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Object/Ptr.hpp"
+
+#include "Benchmark.hpp"
+
+using namespace Pt;
+
+static const size_t NUM_HOT_OBJECTS = 1000;
+static const size_t NUM_COLD_OBJECTS = 200000;
+static const size_t NUM_OPERATIONS = 2000000;
+
+struct Payload : public RefCounted
+{
+    int value = 1;
+};
+
+/// Copy a SharedPtr, call through it and destroy the copy, visiting the objects in the order of indices.
+static double MeasureCopy(const std::vector<SharedPtr<Payload>>& objects, const std::vector<size_t>& indices, long& sum)
+{
+    return MeasureNs(NUM_OPERATIONS, [&]() {
+        size_t j = 0;
+        for (size_t i = 0; i < NUM_OPERATIONS; ++i)
+        {
+            SharedPtr<Payload> copy = objects[indices[j]];
+            sum += copy->value;
+            if (++j == indices.size())
+                j = 0;
+        }
+    });
+}
+
+static std::vector<SharedPtr<Payload>> CreateObjects(size_t count)
+{
+    std::vector<SharedPtr<Payload>> objects;
+    objects.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        objects.emplace_back(new Payload());
+    return objects;
+}
+
+int main()
+{
+    std::mt19937 random(1);
+    long sum = 0;
+
+    // Few objects that stay in cache.
+    {
+        std::vector<SharedPtr<Payload>> objects = CreateObjects(NUM_HOT_OBJECTS);
+        std::vector<size_t> indices(NUM_HOT_OBJECTS);
+        std::iota(indices.begin(), indices.end(), 0);
+        PrintResult("Copy, 1000 hot objects", MeasureCopy(objects, indices, sum));
+    }
+
+    // Many objects visited in random order, so most counts miss the cache.
+    {
+        std::vector<SharedPtr<Payload>> objects = CreateObjects(NUM_COLD_OBJECTS);
+        std::vector<size_t> indices(NUM_COLD_OBJECTS);
+        std::iota(indices.begin(), indices.end(), 0);
+        std::shuffle(indices.begin(), indices.end(), random);
+        PrintResult("Copy, 200k shuffled objects", MeasureCopy(objects, indices, sum));
+    }
+
+    PrintResult("Create and destroy", MeasureNs(NUM_OPERATIONS, [&]() {
+        for (size_t i = 0; i < NUM_OPERATIONS; ++i)
+        {
+            SharedPtr<Payload> object(new Payload());
+            sum += object->value;
+        }
+    }));
+
+    std::printf("checksum %ld\n", sum);
+    return 0;
+}
@@ -5,14 +5,49 @@ namespace Pt
 
 #define PT_DEBUG
 
+// Values of Pt::Level, usable in the preprocessor.
+#define PT_LOG_LEVEL_DEBUG 0
+#define PT_LOG_LEVEL_TRACE 1
+#define PT_LOG_LEVEL_INFO 2
+#define PT_LOG_LEVEL_WARN 3
+#define PT_LOG_LEVEL_ERROR 4
+#define PT_LOG_LEVEL_FATAL 5
+
+#define PT_ENABLE_LOGGING
+// Lowest level compiled in, calls below it generate no code. Define before including to override for a file.
+#ifndef PT_LOG_MIN_LEVEL
+    #ifdef PT_DEBUG
+        #define PT_LOG_MIN_LEVEL PT_LOG_LEVEL_DEBUG
+    #else
+        #define PT_LOG_MIN_LEVEL PT_LOG_LEVEL_INFO
+    #endif
+#endif
+
 #ifdef PT_DEBUG
-    #define PT_ENABLE_LOGGING
     #define PT_LOGGING_COMPACT
     #define PT_ENABLE_ASSERTION
+    // Remember registered strings of hashes and report collisions
+    #define PT_STRING_HASH_REGISTRY
 
     #define PT_SHADER_DEBUG
     // Output all shader source code
     // #define PT_SHADER_DEBUG_SHOW
 #endif
 
+// SIMD instruction sets, define PT_DISABLE_SIMD to use the scalar fallback.
+#ifndef PT_DISABLE_SIMD
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define PT_SIMD_SSE
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #define PT_SIMD_NEON
+    #endif
+    #if defined(__AVX2__)
+        #define PT_SIMD_AVX2
+    #endif
+    #if defined(PT_SIMD_SSE) || defined(PT_SIMD_NEON)
+        /// Float4 maps to a vector register.
+        #define PT_SIMD_FLOAT4
+    #endif
+#endif
+
 } // namespace Pt
\ No newline at end of file
@@ -3,11 +3,10 @@
 #include <glad/glad.h>
 
 #include "Math/IntVector.hpp"
+#include "Graphics/Graphics.hpp"
 
 namespace Pt {
 
-static FrameBuffer* boundFrameBuffer = nullptr;
-
 FrameBuffer::FrameBuffer() :
     m_Handle(0),
     m_Size(IntV2::ZERO)
@@ -22,7 +21,7 @@ FrameBuffer::~FrameBuffer()
 void FrameBuffer::Define(Texture* colorTex, Texture* depthStencilTex)
 {
     glGenFramebuffers(1, &m_Handle);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_Handle);
+    Graphics::BindFrameBuffer(m_Handle);
 
     m_Size = colorTex->Size2D();
 
@@ -46,51 +45,38 @@ void FrameBuffer::Define(Texture* colorTex, Texture* depthStencilTex)
     if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         PT_LOG_ERROR("Framebuffer is not complete!");
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    Graphics::BindFrameBuffer(0);
     PT_LOG_INFO("Created framebuffer: width: ", m_Size.x, ", height: ", m_Size.y);
 }
 
 void FrameBuffer::Bind()
 {
-    if (!m_Handle || boundFrameBuffer == this)
+    if (!m_Handle)
     {
         return;
     }
     
-    glBindFramebuffer(GL_FRAMEBUFFER, m_Handle);
+    Graphics::BindFrameBuffer(m_Handle);
     // FIXME: Viewport set.
-    // glViewport(0, 0, m_Size.x, m_Size.y);
-    boundFrameBuffer = this;
+    // Graphics::SetViewport(IntV2::ZERO, m_Size);
 }
 
 void FrameBuffer::Bind(FrameBuffer* buffer)
 {
-    if (boundFrameBuffer != buffer)
-    {
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, buffer ? buffer->GLHandle() : 0);
-        boundFrameBuffer = buffer;
-    }
+    Graphics::BindFrameBuffer(buffer ? buffer->GLHandle() : 0);
 }
 
 void FrameBuffer::Unbind()
 {
-    if (boundFrameBuffer)
-    {
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
-        boundFrameBuffer = nullptr;
-    }
+    Graphics::BindFrameBuffer(0);
 }
 
 void FrameBuffer::Release()
 {
     if (m_Handle)
     {
-        if (boundFrameBuffer == this)
-        {
-            FrameBuffer::Unbind();
-        }
-
         glDeleteFramebuffers(1, &m_Handle);
+        Graphics::OnFrameBufferDeleted(m_Handle);
         m_Handle = 0;
     }
 
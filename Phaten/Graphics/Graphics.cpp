@@ -1,15 +1,135 @@
 #include "Graphics.hpp"
 
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <glad/glad.h>
 
 #include "IO/Assert.hpp"
 #include "GraphicsDefs.hpp"
+#include "IndexBuffer.hpp"
 #include "ShaderProgram.hpp"
+#include "VertexBuffer.hpp"
 
 namespace Pt {
 
-bool Graphics::sDepthTest = true;
-bool Graphics::sWireframe = false;
+/// Binding in an unknown state, never a valid handle.
+static const unsigned UNKNOWN_HANDLE = ~0u;
+
+/// State as GL has it.
+struct GLState
+{
+    RenderState renderState;
+    /// Whether renderState matches GL, false until the first draw.
+    bool renderStateKnown;
+    /// Blend and cull functions last set, they persist while blending or culling is disabled.
+    BlendMode blendFunc;
+    CullMode cullFace;
+
+    unsigned program;
+    unsigned frameBuffer;
+    unsigned vertexArray;
+    unsigned arrayBuffer;
+    /// Part of the vertex array state.
+    unsigned elementBuffer;
+    unsigned uniformBuffer;
+    unsigned uniformBuffers[MAX_UNIFORM_BUFFER_SLOTS];
+    size_t activeTexture;
+    unsigned textures[MAX_TEXTURE_SLOTS];
+};
+
+static GLState glState;
+/// Counts of the current frame.
+static GraphicsStats frameStats = { 0, 0 };
+/// Render state changes requested since the last draw.
+static unsigned pendingChanges = 0;
+/// Index byte offsets of MultiDrawIndexedBaseVertex(), kept to avoid allocating per call.
+static std::vector<const void*> multiDrawOffsets;
+
+/// Buffers and attributes captured by a cached vertex array.
+/// Keyed by GL handles, entries are dropped when one of the buffers is deleted.
+struct VertexArrayKey
+{
+    unsigned vertexBuffer;
+    unsigned instanceBuffer;
+    unsigned indexBuffer;
+    unsigned attributeMask;
+
+    bool operator == (const VertexArrayKey& rhs) const
+    {
+        return vertexBuffer == rhs.vertexBuffer && instanceBuffer == rhs.instanceBuffer &&
+            indexBuffer == rhs.indexBuffer && attributeMask == rhs.attributeMask;
+    }
+};
+
+struct VertexArrayKeyHash
+{
+    size_t operator () (const VertexArrayKey& key) const
+    {
+        uint64_t buffers = (uint64_t)key.vertexBuffer << 32 | key.indexBuffer;
+        uint64_t rest = (uint64_t)key.instanceBuffer << 32 | key.attributeMask;
+        return std::hash<uint64_t>()(buffers ^ (rest * 0x9E3779B97F4A7C15ull));
+    }
+};
+
+/// Vertex array used by VertexBuffer::Bind(), created with the context.
+static unsigned defaultVertexArray = 0;
+static std::unordered_map<VertexArrayKey, unsigned, VertexArrayKeyHash> vertexArrays;
+
+RenderState Graphics::sRenderState = {
+    true,
+    true,
+    CompareMode::LESS_EQUAL,
+    BlendMode::REPLACE,
+    CullMode::NONE,
+    false,
+    false,
+    IntV2(0, 0),
+    IntV2(0, 0),
+    IntV2(0, 0),
+    IntV2(0, 0),
+    Vector4(0.0f, 0.0f, 0.0f, 0.0f)
+};
+GraphicsStats Graphics::sFrameStats = { 0, 0 };
+
+/// Record a requested render state value, counting requests that change nothing.
+template <typename T>
+static void RequestState(T& state, const T& value)
+{
+    if (state == value)
+    {
+        ++frameStats.filtered;
+        return;
+    }
+    state = value;
+    ++pendingChanges;
+}
+
+/// Count a binding request. Return true if it needs a GL call.
+static bool RequestBinding(unsigned& binding, unsigned handle)
+{
+    if (binding == handle)
+    {
+        ++frameStats.filtered;
+        return false;
+    }
+    binding = handle;
+    ++frameStats.issued;
+    return true;
+}
+
+static unsigned* BufferBinding(unsigned target)
+{
+    switch (target)
+    {
+        case GL_ARRAY_BUFFER:           return &glState.arrayBuffer;
+        case GL_ELEMENT_ARRAY_BUFFER:   return &glState.elementBuffer;
+        case GL_UNIFORM_BUFFER:         return &glState.uniformBuffer;
+        default:                        return nullptr;
+    }
+}
 
 Graphics::Graphics(const SharedPtr<Window>& window) :
     m_VSync(true),
@@ -22,18 +142,28 @@ Graphics::Graphics(const SharedPtr<Window>& window) :
     // Use the window handle to create the graphics context.
     m_GraphicsContext = CreateScoped<GraphicsContext>(m_Window->SDLHandle());
 
-    // Create a default VAO and use forever :D
-    unsigned defaultVAO;
-    glGenVertexArrays(1, &defaultVAO);
-    glBindVertexArray(defaultVAO);
+    // The context is new, nothing is known about its state.
+    ResetState();
+
+    // Default VAO for buffers bound one by one, BindGeometry() caches the others.
+    glGenVertexArrays(1, &defaultVertexArray);
+    BindVertexArray(defaultVertexArray);
 
     SetVSync(m_VSync);
+    SetViewport(IntV2::ZERO, Size());
     // Initialization Done ====================================================
-    SetDepthTest(sDepthTest);
 }
 
 Graphics::~Graphics()
 {
+    for (const auto& [key, handle] : vertexArrays)
+    {
+        glDeleteVertexArrays(1, &handle);
+    }
+    vertexArrays.clear();
+    glDeleteVertexArrays(1, &defaultVertexArray);
+    defaultVertexArray = 0;
+
     PT_TAG_INFO("Graphics", "Exited graphics system");
     Object::RemoveSubsystem(this);
 }
@@ -46,39 +176,368 @@ void Graphics::SetVSync(bool enable)
 
 void Graphics::SetClearColor(const Vector4& color)
 {
-    glClearColor(color.x, color.y, color.z, color.w);
+    RequestState(sRenderState.clearColor, color);
 }
 
 void Graphics::SetDepthTest(bool enable)
-{    
+{
+    RequestState(sRenderState.depthTest, enable);
+}
+
+void Graphics::SetDepthWrite(bool enable)
+{
+    RequestState(sRenderState.depthWrite, enable);
+}
+
+void Graphics::SetDepthFunc(CompareMode mode)
+{
+    RequestState(sRenderState.depthFunc, mode);
+}
+
+void Graphics::SetBlendMode(BlendMode mode)
+{
+    RequestState(sRenderState.blendMode, mode);
+}
+
+void Graphics::SetCullMode(CullMode mode)
+{
+    RequestState(sRenderState.cullMode, mode);
+}
+
+void Graphics::SetWireframe(bool enable)
+{
+    RequestState(sRenderState.wireframe, enable);
+}
+
+void Graphics::SetViewport(const IntV2& position, const IntV2& size)
+{
+    std::pair<IntV2, IntV2> viewport(sRenderState.viewportPosition, sRenderState.viewportSize);
+    RequestState(viewport, std::make_pair(position, size));
+    sRenderState.viewportPosition = position;
+    sRenderState.viewportSize = size;
+}
+
+void Graphics::SetScissorTest(bool enable, const IntV2& position, const IntV2& size)
+{
+    RequestState(sRenderState.scissorTest, enable);
+    // The rectangle is kept while disabled.
     if (enable)
     {
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LEQUAL);
+        std::pair<IntV2, IntV2> scissor(sRenderState.scissorPosition, sRenderState.scissorSize);
+        RequestState(scissor, std::make_pair(position, size));
+        sRenderState.scissorPosition = position;
+        sRenderState.scissorSize = size;
     }
-    else
+}
+
+void Graphics::BindProgram(unsigned handle)
+{
+    if (RequestBinding(glState.program, handle))
     {
-        glDisable(GL_DEPTH_TEST);
+        glUseProgram(handle);
     }
-    sDepthTest = enable;
 }
 
-void Graphics::SetWireframe(bool enable)
+void Graphics::BindFrameBuffer(unsigned handle)
 {
-    if (enable)
+    if (RequestBinding(glState.frameBuffer, handle))
     {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        glBindFramebuffer(GL_FRAMEBUFFER, handle);
     }
-    else
+}
+
+void Graphics::BindVertexArray(unsigned handle)
+{
+    if (RequestBinding(glState.vertexArray, handle))
+    {
+        glBindVertexArray(handle);
+        // Each vertex array has its own index buffer binding.
+        glState.elementBuffer = UNKNOWN_HANDLE;
+    }
+}
+
+void Graphics::BindGeometry(VertexBuffer* vertexBuffer, IndexBuffer* indexBuffer, unsigned attributeMask,
+    VertexBuffer* instanceBuffer)
+{
+    VertexArrayKey key{
+        vertexBuffer ? vertexBuffer->GLHandle() : 0,
+        instanceBuffer ? instanceBuffer->GLHandle() : 0,
+        indexBuffer ? indexBuffer->GLHandle() : 0,
+        attributeMask
+    };
+
+    auto it = vertexArrays.find(key);
+    if (it != vertexArrays.end())
     {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        BindVertexArray(it->second);
+        // Restored with the vertex array.
+        glState.elementBuffer = key.indexBuffer;
+        return;
     }
-    sWireframe = enable;
+
+    unsigned handle;
+    glGenVertexArrays(1, &handle);
+    BindVertexArray(handle);
+    if (vertexBuffer)
+    {
+        vertexBuffer->SpecifyAttributes(attributeMask);
+    }
+    if (instanceBuffer)
+    {
+        instanceBuffer->SpecifyAttributes(attributeMask);
+    }
+    // Not IndexBuffer::Bind(), which binds to the default vertex array.
+    BindBuffer(GL_ELEMENT_ARRAY_BUFFER, key.indexBuffer);
+
+    vertexArrays.emplace(key, handle);
+}
+
+void Graphics::BindDefaultVertexArray()
+{
+    BindVertexArray(defaultVertexArray);
+}
+
+size_t Graphics::NumVertexArrays()
+{
+    return vertexArrays.size();
+}
+
+void Graphics::BindBuffer(unsigned target, unsigned handle)
+{
+    unsigned* binding = BufferBinding(target);
+    if (!binding)
+    {
+        glBindBuffer(target, handle);
+        ++frameStats.issued;
+    }
+    else if (RequestBinding(*binding, handle))
+    {
+        glBindBuffer(target, handle);
+    }
+}
+
+void Graphics::BindUniformBuffer(size_t index, unsigned handle, size_t sizeByte)
+{
+    if (RequestBinding(glState.uniformBuffers[index], handle))
+    {
+        glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(index), handle, 0, sizeByte);
+        // Also binds the generic binding point.
+        glState.uniformBuffer = handle;
+    }
+}
+
+static void SelectTextureUnit(size_t index)
+{
+    if (glState.activeTexture != index)
+    {
+        glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(index));
+        glState.activeTexture = index;
+        ++frameStats.issued;
+    }
+}
+
+void Graphics::BindTexture(size_t index, unsigned target, unsigned handle)
+{
+    if (!RequestBinding(glState.textures[index], handle))
+    {
+        return;
+    }
+
+    SelectTextureUnit(index);
+    glBindTexture(target, handle);
+}
+
+void Graphics::BindTextureForUpdate(unsigned target, unsigned handle)
+{
+    // Texture updates act on the active unit, so select it even when the binding is cached.
+    SelectTextureUnit(0);
+    if (RequestBinding(glState.textures[0], handle))
+    {
+        glBindTexture(target, handle);
+    }
+}
+
+void Graphics::OnProgramDeleted(unsigned handle)
+{
+    // A deleted program stays in use until another is bound.
+    if (glState.program == handle)
+    {
+        glState.program = UNKNOWN_HANDLE;
+    }
+}
+
+void Graphics::OnFrameBufferDeleted(unsigned handle)
+{
+    if (glState.frameBuffer == handle)
+    {
+        glState.frameBuffer = UNKNOWN_HANDLE;
+    }
+}
+
+void Graphics::OnVertexArrayDeleted(unsigned handle)
+{
+    if (glState.vertexArray == handle)
+    {
+        glState.vertexArray = UNKNOWN_HANDLE;
+        glState.elementBuffer = UNKNOWN_HANDLE;
+    }
+}
+
+void Graphics::OnBufferDeleted(unsigned handle)
+{
+    // Vertex arrays would keep the buffer alive and GL may reuse the handle.
+    for (auto it = vertexArrays.begin(); it != vertexArrays.end();)
+    {
+        const VertexArrayKey& key = it->first;
+        if (key.vertexBuffer == handle || key.instanceBuffer == handle || key.indexBuffer == handle)
+        {
+            glDeleteVertexArrays(1, &it->second);
+            OnVertexArrayDeleted(it->second);
+            it = vertexArrays.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (unsigned* binding : { &glState.arrayBuffer, &glState.elementBuffer, &glState.uniformBuffer })
+    {
+        if (*binding == handle)
+        {
+            *binding = UNKNOWN_HANDLE;
+        }
+    }
+    for (unsigned& binding : glState.uniformBuffers)
+    {
+        if (binding == handle)
+        {
+            binding = UNKNOWN_HANDLE;
+        }
+    }
+}
+
+void Graphics::OnTextureDeleted(unsigned handle)
+{
+    for (unsigned& binding : glState.textures)
+    {
+        if (binding == handle)
+        {
+            binding = UNKNOWN_HANDLE;
+        }
+    }
+}
+
+void Graphics::ResetState()
+{
+    glState.renderStateKnown = false;
+    glState.blendFunc = BlendMode::MAX_BLEND_MODE;
+    glState.cullFace = CullMode::MAX_CULL_MODE;
+
+    glState.program = UNKNOWN_HANDLE;
+    glState.frameBuffer = UNKNOWN_HANDLE;
+    glState.vertexArray = UNKNOWN_HANDLE;
+    glState.arrayBuffer = UNKNOWN_HANDLE;
+    glState.elementBuffer = UNKNOWN_HANDLE;
+    glState.uniformBuffer = UNKNOWN_HANDLE;
+    for (unsigned& binding : glState.uniformBuffers)
+    {
+        binding = UNKNOWN_HANDLE;
+    }
+    glState.activeTexture = MAX_TEXTURE_SLOTS;
+    for (unsigned& binding : glState.textures)
+    {
+        binding = UNKNOWN_HANDLE;
+    }
+}
+
+void Graphics::PrepareDraw()
+{
+    RenderState& current = glState.renderState;
+    const RenderState& state = sRenderState;
+    bool all = !glState.renderStateKnown;
+    unsigned applied = 0;
+
+    if (all || state.depthTest != current.depthTest)
+    {
+        state.depthTest ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST);
+        ++applied;
+    }
+    if (all || state.depthWrite != current.depthWrite)
+    {
+        glDepthMask(state.depthWrite ? GL_TRUE : GL_FALSE);
+        ++applied;
+    }
+    if (all || state.depthFunc != current.depthFunc)
+    {
+        glDepthFunc(CompareModeGLType[EnumAsIndex(state.depthFunc)]);
+        ++applied;
+    }
+
+    bool blend = state.blendMode != BlendMode::REPLACE;
+    if (all || blend != (current.blendMode != BlendMode::REPLACE))
+    {
+        blend ? glEnable(GL_BLEND) : glDisable(GL_BLEND);
+        ++applied;
+    }
+    if (blend && state.blendMode != glState.blendFunc)
+    {
+        glBlendFunc(BlendModeGLSrcFactor[EnumAsIndex(state.blendMode)], BlendModeGLDstFactor[EnumAsIndex(state.blendMode)]);
+        glState.blendFunc = state.blendMode;
+        ++applied;
+    }
+
+    bool cull = state.cullMode != CullMode::NONE;
+    if (all || cull != (current.cullMode != CullMode::NONE))
+    {
+        cull ? glEnable(GL_CULL_FACE) : glDisable(GL_CULL_FACE);
+        ++applied;
+    }
+    if (cull && state.cullMode != glState.cullFace)
+    {
+        glCullFace(CullModeGLType[EnumAsIndex(state.cullMode)]);
+        glState.cullFace = state.cullMode;
+        ++applied;
+    }
+
+    if (all || state.wireframe != current.wireframe)
+    {
+        glPolygonMode(GL_FRONT_AND_BACK, state.wireframe ? GL_LINE : GL_FILL);
+        ++applied;
+    }
+    if (all || state.viewportPosition != current.viewportPosition || state.viewportSize != current.viewportSize)
+    {
+        glViewport(state.viewportPosition.x, state.viewportPosition.y, state.viewportSize.x, state.viewportSize.y);
+        ++applied;
+    }
+    if (all || state.scissorTest != current.scissorTest)
+    {
+        state.scissorTest ? glEnable(GL_SCISSOR_TEST) : glDisable(GL_SCISSOR_TEST);
+        ++applied;
+    }
+    if (all || state.scissorPosition != current.scissorPosition || state.scissorSize != current.scissorSize)
+    {
+        glScissor(state.scissorPosition.x, state.scissorPosition.y, state.scissorSize.x, state.scissorSize.y);
+        ++applied;
+    }
+    if (all || state.clearColor != current.clearColor)
+    {
+        glClearColor(state.clearColor.x, state.clearColor.y, state.clearColor.z, state.clearColor.w);
+        ++applied;
+    }
+
+    current = state;
+    glState.renderStateKnown = true;
+
+    // Changes that were undone before reaching GL.
+    frameStats.issued += applied;
+    frameStats.filtered += pendingChanges > applied ? pendingChanges - applied : 0;
+    pendingChanges = 0;
 }
 
 SharedPtr<Shader> Graphics::LoadShader(std::string_view name)
 {
-    auto hash = StringHash(name);
+    auto hash = StringHash::Register(name);
     auto it = m_Shaders.find(hash);
     if (it != m_Shaders.end())
     {
@@ -217,6 +676,138 @@ void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, std::string_v
     }
 }
 
+void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, std::string_view name, const Vector2& value)
+{
+    if (program)
+    {
+        int location = program->Uniform(name);
+        if (location >= 0)
+        {
+            glUniform2f(location, value.x, value.y);
+        }
+    }
+}
+
+void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, std::string_view name, const Vector3& value)
+{
+    if (program)
+    {
+        int location = program->Uniform(name);
+        if (location >= 0)
+        {
+            glUniform3f(location, value.x, value.y, value.z);
+        }
+    }
+}
+
+void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, std::string_view name, const Vector4& value)
+{
+    if (program)
+    {
+        int location = program->Uniform(name);
+        if (location >= 0)
+        {
+            glUniform4f(location, value.x, value.y, value.z, value.w);
+        }
+    }
+}
+
+void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, std::string_view name, const Matrix4& value)
+{
+    if (program)
+    {
+        int location = program->Uniform(name);
+        if (location >= 0)
+        {
+            glUniformMatrix4fv(location, 1, GL_FALSE, value.Data());
+        }
+    }
+}
+
+void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, int value)
+{
+    if (program)
+    {
+        int location = program->Uniform(name);
+        if (location >= 0)
+        {
+            glUniform1i(location, value);
+        }
+    }
+}
+
+void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, int* values, size_t count)
+{
+    if (program)
+    {
+        int location = program->Uniform(name);
+        if (location >= 0)
+        {
+            glUniform1iv(location, count, values);
+        }
+    }
+}
+
+void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, float value)
+{
+    if (program)
+    {
+        int location = program->Uniform(name);
+        if (location >= 0)
+        {
+            glUniform1f(location, value);
+        }
+    }
+}
+
+void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, const Vector2& value)
+{
+    if (program)
+    {
+        int location = program->Uniform(name);
+        if (location >= 0)
+        {
+            glUniform2f(location, value.x, value.y);
+        }
+    }
+}
+
+void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, const Vector3& value)
+{
+    if (program)
+    {
+        int location = program->Uniform(name);
+        if (location >= 0)
+        {
+            glUniform3f(location, value.x, value.y, value.z);
+        }
+    }
+}
+
+void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, const Vector4& value)
+{
+    if (program)
+    {
+        int location = program->Uniform(name);
+        if (location >= 0)
+        {
+            glUniform4f(location, value.x, value.y, value.z, value.w);
+        }
+    }
+}
+
+void Graphics::SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, const Matrix4& value)
+{
+    if (program)
+    {
+        int location = program->Uniform(name);
+        if (location >= 0)
+        {
+            glUniformMatrix4fv(location, 1, GL_FALSE, value.Data());
+        }
+    }
+}
+
 void Graphics::SetFrameBuffer(const SharedPtr<FrameBuffer>& frameBuffer)
 {
     if (frameBuffer)
@@ -242,10 +833,12 @@ void* Graphics::GetNativeWindow() const
 
 void Graphics::Draw(PrimitiveType type, size_t first, size_t count)
 {
+    PrepareDraw();
     glDrawArrays(PrimitiveGLType[EnumAsIndex(type)], first, count);
 }
 void Graphics::DrawIndexed(PrimitiveType type, size_t first, size_t count)
-{   
+{
+    PrepareDraw();
     glDrawElements(
         PrimitiveGLType[EnumAsIndex(type)],
         count,
@@ -253,14 +846,69 @@ void Graphics::DrawIndexed(PrimitiveType type, size_t first, size_t count)
         (void*)(first * sizeof(unsigned))
     );
 }
+void Graphics::DrawInstanced(PrimitiveType type, size_t first, size_t count, size_t numInstances)
+{
+    PrepareDraw();
+    glDrawArraysInstanced(PrimitiveGLType[EnumAsIndex(type)], first, count, numInstances);
+}
+void Graphics::DrawIndexedInstanced(PrimitiveType type, size_t first, size_t count, size_t numInstances)
+{
+    PrepareDraw();
+    glDrawElementsInstanced(
+        PrimitiveGLType[EnumAsIndex(type)],
+        count,
+        GL_UNSIGNED_INT,
+        (void*)(first * sizeof(unsigned)),
+        numInstances
+    );
+}
+void Graphics::DrawIndexedBaseVertex(PrimitiveType type, size_t first, size_t count, int baseVertex)
+{
+    PrepareDraw();
+    glDrawElementsBaseVertex(
+        PrimitiveGLType[EnumAsIndex(type)],
+        count,
+        GL_UNSIGNED_INT,
+        (void*)(first * sizeof(unsigned)),
+        baseVertex
+    );
+}
+void Graphics::MultiDrawIndexedBaseVertex(PrimitiveType type, const int* counts, const unsigned* firsts,
+    const int* baseVertices, size_t drawCount)
+{
+    // GL takes byte offsets into the index buffer as pointers.
+    multiDrawOffsets.resize(drawCount);
+    for (size_t i = 0; i < drawCount; ++i)
+    {
+        multiDrawOffsets[i] = (void*)(firsts[i] * sizeof(unsigned));
+    }
+
+    PrepareDraw();
+    glMultiDrawElementsBaseVertex(
+        PrimitiveGLType[EnumAsIndex(type)],
+        counts,
+        GL_UNSIGNED_INT,
+        multiDrawOffsets.data(),
+        drawCount,
+        baseVertices
+    );
+}
 
 void Graphics::Present()
 {
     m_Window->Swap();
+
+    sFrameStats = frameStats;
+    frameStats = GraphicsStats{ 0, 0 };
+
+    m_FrameAllocator.Reset();
+    m_DoubleBufferedAllocator.Swap();
 }
 
 void Graphics::Clear(unsigned bits)
 {
+    // Clears depend on the clear color, depth write and scissor.
+    PrepareDraw();
     glClear(BufferBitsToGLBits(bits));
 }
 
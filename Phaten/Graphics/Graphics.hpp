@@ -4,6 +4,7 @@
 
 #include "Object/Ptr.hpp"
 #include "Object/Object.hpp"
+#include "Object/LinearAllocator.hpp"
 #include "IO/StringHash.hpp"
 #include "Input/Window.hpp"
 
@@ -11,6 +12,7 @@
 #include "Math/Matrix.hpp"
 
 #include "GraphicsContext.hpp"
+#include "GraphicsDefs.hpp"
 #include "Shader.hpp"
 #include "FrameBuffer.hpp"
 
@@ -18,9 +20,39 @@ struct SDL_Window;
 
 namespace Pt {
 
+class IndexBuffer;
 class ShaderProgram;
+class VertexBuffer;
+
+/// Fixed-function state. Applied by Graphics before draws and clears.
+struct RenderState
+{
+    bool depthTest;
+    bool depthWrite;
+    CompareMode depthFunc;
+    BlendMode blendMode;
+    CullMode cullMode;
+    bool wireframe;
+    bool scissorTest;
+    IntV2 scissorPosition;
+    IntV2 scissorSize;
+    IntV2 viewportPosition;
+    IntV2 viewportSize;
+    Vector4 clearColor;
+};
+
+/// State changes and bindings requested in a frame.
+struct GraphicsStats
+{
+    /// Changes sent to GL.
+    unsigned issued;
+    /// Requests that were already in effect, or undone before the next draw.
+    unsigned filtered;
+};
 
 /// Graphics API interface.
+/// GL state is only changed through Graphics, which skips calls that would not change it.
+/// Render state is applied lazily, so toggling it around a draw costs nothing. Bindings are applied immediately.
 class Graphics : public Object
 {
     OBJECT(Graphics);
@@ -31,7 +63,41 @@ public:
     void SetVSync(bool enable);
     static void SetClearColor(const Vector4& color = Vector4(0.0f, 0.0f, 0.0f, 1.0f));
     static void SetDepthTest(bool enable);
+    static void SetDepthWrite(bool enable);
+    static void SetDepthFunc(CompareMode mode);
+    static void SetBlendMode(BlendMode mode);
+    static void SetCullMode(CullMode mode);
     static void SetWireframe(bool enable);
+    static void SetViewport(const IntV2& position, const IntV2& size);
+    static void SetScissorTest(bool enable, const IntV2& position = IntV2::ZERO, const IntV2& size = IntV2::ZERO);
+
+    /// Bind GL objects by handle. Used by the resource classes.
+    static void BindProgram(unsigned handle);
+    static void BindFrameBuffer(unsigned handle);
+    static void BindVertexArray(unsigned handle);
+    /// Bind to GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER or GL_UNIFORM_BUFFER.
+    static void BindBuffer(unsigned target, unsigned handle);
+    static void BindUniformBuffer(size_t index, unsigned handle, size_t sizeByte);
+    static void BindTexture(size_t index, unsigned target, unsigned handle);
+    /// Bind to unit 0 and make it the active unit, for glTexImage and glTexParameter calls.
+    static void BindTextureForUpdate(unsigned target, unsigned handle);
+    /// Bind a vertex array reading attributeMask from the buffers, created on first use and cached after.
+    /// Switching meshes is then a single glBindVertexArray. indexBuffer and instanceBuffer may be null.
+    static void BindGeometry(VertexBuffer* vertexBuffer, IndexBuffer* indexBuffer, unsigned attributeMask,
+        VertexBuffer* instanceBuffer = nullptr);
+    /// Bind the vertex array used by VertexBuffer::Bind() and IndexBuffer::Bind().
+    static void BindDefaultVertexArray();
+    /// Return number of cached vertex arrays.
+    static size_t NumVertexArrays();
+    /// Forget bindings of deleted objects, GL may reuse their handles.
+    static void OnProgramDeleted(unsigned handle);
+    static void OnFrameBufferDeleted(unsigned handle);
+    static void OnVertexArrayDeleted(unsigned handle);
+    static void OnBufferDeleted(unsigned handle);
+    static void OnTextureDeleted(unsigned handle);
+    /// Forget all cached state. Call after GL state was changed outside Graphics.
+    /// Cached vertex arrays are kept.
+    static void ResetState();
 
     /// Load a shader from file. Or return the existing one.
     SharedPtr<Shader> LoadShader(std::string_view name);
@@ -51,34 +117,65 @@ public:
     void SetUniform(const SharedPtr<ShaderProgram>& program, std::string_view name, const Vector2& value);
     void SetUniform(const SharedPtr<ShaderProgram>& program, std::string_view name, const Vector3& value);
     void SetUniform(const SharedPtr<ShaderProgram>& program, std::string_view name, const Vector4& value);
+    void SetUniform(const SharedPtr<ShaderProgram>& program, std::string_view name, const Matrix4& value);
+    /// Set uniform by hashed name, e.g. "u_Time"_hash. Looks up the locations cached when the program was linked.
+    void SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, int value);
+    void SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, int* values, size_t count);
+    void SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, float value);
+    void SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, const Vector2& value);
+    void SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, const Vector3& value);
+    void SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, const Vector4& value);
+    void SetUniform(const SharedPtr<ShaderProgram>& program, StringHash name, const Matrix4& value);
 
     static void SetFrameBuffer(const SharedPtr<FrameBuffer>& frameBuffer);
 
     bool IsInitialized() const { return m_GraphicsContext != nullptr; }
     bool IsVSync() const { return m_VSync; }
-    static bool IsDepthTest() { return sDepthTest; }
-    static bool IsWireframe() { return sWireframe; }
+    static bool IsDepthTest() { return sRenderState.depthTest; }
+    static bool IsWireframe() { return sRenderState.wireframe; }
+    static const RenderState& GetRenderState() { return sRenderState; }
+    /// Return counts of the previous frame.
+    static const GraphicsStats& FrameStats() { return sFrameStats; }
 
     static void Draw(PrimitiveType type, size_t first, size_t count);
     static void DrawIndexed(PrimitiveType type, size_t first, size_t count);
+    /// Draw numInstances copies in one call. Per-instance attributes come from buffers set with SetPerInstance().
+    static void DrawInstanced(PrimitiveType type, size_t first, size_t count, size_t numInstances);
+    static void DrawIndexedInstanced(PrimitiveType type, size_t first, size_t count, size_t numInstances);
+    /// Draw indices offset by baseVertex, for meshes sharing one vertex buffer.
+    static void DrawIndexedBaseVertex(PrimitiveType type, size_t first, size_t count, int baseVertex);
+    /// Issue drawCount indexed draws in one call. Firsts are in indices.
+    static void MultiDrawIndexedBaseVertex(PrimitiveType type, const int* counts, const unsigned* firsts,
+        const int* baseVertices, size_t drawCount);
 
     IntV2 Size() const;
     void* GetNativeWindow() const;
     WeakPtr<Window> GetWindow() const { return m_Window; }
+    /// Return allocator for data used only in the current frame. Main thread only.
+    LinearAllocator& GetFrameAllocator() { return m_FrameAllocator; }
+    /// Return allocator for data used in the current and the next frame. Main thread only.
+    DoubleBufferedAllocator& GetDoubleBufferedAllocator() { return m_DoubleBufferedAllocator; }
 
-    /// Swap window buffer.
+    /// Swap window buffer and release frame allocations.
     void Present();
     /// Clear the screen.
     static void Clear(unsigned bits = 1);
 private:
+    /// Apply render state that differs from GL.
+    static void PrepareDraw();
+
     bool m_VSync;
-    static bool sDepthTest;
-    static bool sWireframe;
+    /// Requested render state.
+    static RenderState sRenderState;
+    static GraphicsStats sFrameStats;
 
     SharedPtr<Window> m_Window;
     ScopedPtr<GraphicsContext> m_GraphicsContext;
 
     std::map<StringHash, SharedPtr<Shader>> m_Shaders;
+
+    LinearAllocator m_FrameAllocator;
+    DoubleBufferedAllocator m_DoubleBufferedAllocator;
 };
 
 void RegisterGraphcisLibrary();
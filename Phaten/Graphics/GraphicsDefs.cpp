@@ -64,6 +64,11 @@ const unsigned VertexAttributeIdx[]
     2, // TANGENT
     3, // VERTEX_COLOR
     4, // TEX_COORD
+    5, // INSTANCE_MATRIX0
+    6, // INSTANCE_MATRIX1
+    7, // INSTANCE_MATRIX2
+    8, // INSTANCE_MATRIX3
+    9, // INSTANCE_PARAMS
 };
 
 const std::string VertexAttributeName[]
@@ -73,6 +78,12 @@ const std::string VertexAttributeName[]
     "aTangent",
     "aVertexColor",
     "aTexCoord",
+    // A mat4 attribute takes four locations, only the first is reported by name.
+    "aInstanceModel",
+    "aInstanceModel[1]",
+    "aInstanceModel[2]",
+    "aInstanceModel[3]",
+    "aInstanceParams",
     ""
 };
 
@@ -83,6 +94,11 @@ const std::string VertexElementSemanticName[]
     "TANGENT",
     "VERTEX_COLOR",
     "TEX_COORD",
+    "INSTANCE_MATRIX0",
+    "INSTANCE_MATRIX1",
+    "INSTANCE_MATRIX2",
+    "INSTANCE_MATRIX3",
+    "INSTANCE_PARAMS",
     ""
 };
 
@@ -214,6 +230,43 @@ const GLenum TextureFilterModeGLType[]
     GL_LINEAR
 };
 
+const GLenum CompareModeGLType[]
+{
+    GL_ALWAYS,
+    GL_NEVER,
+    GL_EQUAL,
+    GL_NOTEQUAL,
+    GL_LESS,
+    GL_LEQUAL,
+    GL_GREATER,
+    GL_GEQUAL
+};
+
+const GLenum BlendModeGLSrcFactor[]
+{
+    GL_ONE,
+    GL_SRC_ALPHA,
+    GL_ONE,
+    GL_ONE,
+    GL_DST_COLOR
+};
+
+const GLenum BlendModeGLDstFactor[]
+{
+    GL_ZERO,
+    GL_ONE_MINUS_SRC_ALPHA,
+    GL_ONE_MINUS_SRC_ALPHA,
+    GL_ONE,
+    GL_ZERO
+};
+
+const GLenum CullModeGLType[]
+{
+    0,
+    GL_BACK,
+    GL_FRONT
+};
+
 std::string AttributesBitToString(unsigned attributes)
 {
     return std::bitset<8>(attributes).to_string();
@@ -94,6 +94,13 @@ enum class VertexElementSemantic : size_t
     TANGENT,
     VERTEX_COLOR,
     TEX_COORD,
+    /// Columns of a per-instance model matrix.
+    INSTANCE_MATRIX0,
+    INSTANCE_MATRIX1,
+    INSTANCE_MATRIX2,
+    INSTANCE_MATRIX3,
+    /// Per-instance parameters, e.g. a color.
+    INSTANCE_PARAMS,
     MAX_ELEMENT_SEMANTIC
 };
 
@@ -104,6 +111,11 @@ enum class VertexAttributeType : size_t
     TANGENT,
     VERTEX_COLOR,
     TEX_COORD,
+    INSTANCE_MATRIX0,
+    INSTANCE_MATRIX1,
+    INSTANCE_MATRIX2,
+    INSTANCE_MATRIX3,
+    INSTANCE_PARAMS,
     MAX_ATTRIBUTE
 };
 
@@ -150,6 +162,40 @@ enum class TextureFilterMode
     MAX_FILTER_MODE
 };
 
+/// Depth test function.
+enum class CompareMode
+{
+    ALWAYS = 0,
+    NEVER,
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+    MAX_COMPARE_MODE
+};
+
+/// Blending of fragment and framebuffer colors. REPLACE disables blending.
+enum class BlendMode
+{
+    REPLACE = 0,
+    ALPHA,
+    PREMULTIPLIED_ALPHA,
+    ADD,
+    MULTIPLY,
+    MAX_BLEND_MODE
+};
+
+/// Faces to discard. NONE disables culling.
+enum class CullMode
+{
+    NONE = 0,
+    BACK,
+    FRONT,
+    MAX_CULL_MODE
+};
+
 extern const unsigned BufferBitGLType[];
 unsigned BufferBitsToGLBits(unsigned bits);
 
@@ -173,6 +219,11 @@ extern const GLenum TextureTypeGLTarget[];
 extern const GLenum TextureWrapModeGLType[];
 extern const GLenum TextureFilterModeGLType[];
 
+extern const GLenum CompareModeGLType[];
+extern const GLenum BlendModeGLSrcFactor[];
+extern const GLenum BlendModeGLDstFactor[];
+extern const GLenum CullModeGLType[];
+
 
 template <typename T>
 constexpr size_t EnumAsIndex(T type)
@@ -89,12 +89,14 @@ bool IndexBuffer::SetData(size_t startIdx, size_t numIndices, const void *data,
 
 void IndexBuffer::Bind()
 {
-    if (!m_Handle || boundIndexBuffer == this)
+    if (!m_Handle)
     {
         return;
     }
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Handle);
+    // Index buffer binding is vertex array state, keep cached vertex arrays untouched.
+    Graphics::BindDefaultVertexArray();
+    Graphics::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Handle);
 
     boundIndexCount = m_NumIndices;
     boundIndexBuffer = this;
@@ -127,6 +129,7 @@ void IndexBuffer::Release()
     if(m_Handle)
     {
         glDeleteBuffers(1, &m_Handle);
+        Graphics::OnBufferDeleted(m_Handle);
         m_Handle = 0;
 
         if (boundIndexBuffer == this)
@@ -15,7 +15,7 @@ public:
     bool Define(BufferUsage usage, size_t numIndices, const void* data = nullptr);
     /// Update buffer data, dicard means discard all old data.
     bool SetData(size_t startIdx, size_t numIndices, const void* data, bool discard = false);
-    /// Bind index buffer.
+    /// Bind index buffer to the default vertex array.
     void Bind();
 
     /// Get OpenGL object handle.
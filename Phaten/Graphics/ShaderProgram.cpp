@@ -12,7 +12,6 @@
 
 namespace Pt {
 
-static ShaderProgram* boundProgram = nullptr;
 /// Max buffer length for shader attribute name querying
 static const size_t MAX_NAME_LENGTH = 256;
 
@@ -62,13 +61,7 @@ bool ShaderProgram::Bind()
         return false;
     }
 
-    if (boundProgram == this)
-    {
-        return true;
-    }
-
-    glUseProgram(m_Handle);
-    boundProgram = this;
+    Graphics::BindProgram(m_Handle);
     return true;
 }
 
@@ -88,8 +81,8 @@ int ShaderProgram::Uniform(std::string_view name)
         return -1;
     }
 
-    // cache uniform location
-    m_Uniforms[StringHash(name)] = location;
+    // cache uniform location, only misses register the name
+    m_Uniforms[StringHash::Register(name)] = location;
     return location;
 }
 
@@ -180,9 +173,11 @@ void ShaderProgram::Create(
 
         std::string attributeName(nameBuffer, nameLength);
         size_t attributeIdx = IndexOfList(attributeName, VertexAttributeName, 0x7F);
-        if (m_Attributes < 32)
+        if (attributeIdx < EnumAsIndex(VertexAttributeType::MAX_ATTRIBUTE))
         {
-            m_Attributes |= (1 << attributeIdx);
+            // Matrices use a location per column.
+            unsigned numLocations = queryGLType == GL_FLOAT_MAT4 ? 4 : 1;
+            m_Attributes |= ((1 << numLocations) - 1) << attributeIdx;
         }
     }
 #ifdef PT_SHADER_DEBUG
@@ -225,7 +220,7 @@ void ShaderProgram::Create(
         // Remove [0] if uniform is an array.(not neccessery but recommend doing this)
         ReplaceIn(uniformName, "[0]", ""); 
         int location = glGetUniformLocation(m_Handle, uniformName.c_str());
-        m_Uniforms[StringHash(uniformName)] = location;
+        m_Uniforms[StringHash::Register(uniformName)] = location;
 
         size_t preset = IndexOfList(uniformName, PresetUniformName, MAX_NAME_LENGTH);
         if (preset < EnumAsIndex(PresetUniform::MAX_PRESET_UNIFORMS))
@@ -291,12 +286,8 @@ void ShaderProgram::Release()
     if (m_Handle)
     {
         glDeleteProgram(m_Handle);
+        Graphics::OnProgramDeleted(m_Handle);
         m_Handle = 0;
-
-        if (boundProgram == this)
-        {
-            boundProgram = nullptr;
-        }
     }
 }
 
@@ -16,8 +16,6 @@ static size_t ImageFormatToPixelByte[] =
     4
 };
 
-static const Texture* boundTextureSlot[MAX_TEXTURE_SLOTS] = { nullptr };
-
 Texture::Texture() :
     m_Handle(0),
     m_Target(0),
@@ -43,6 +41,31 @@ void Texture::RegisterObject()
     Object::RegisterFactory<Texture>();
 }
 
+bool Texture::BeginLoad()
+{
+    m_LoadImage = new Image();
+    m_LoadImage->SetName(Name());
+    if (!m_LoadImage->BeginLoad())
+    {
+        m_LoadImage.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+bool Texture::EndLoad()
+{
+    if (!m_LoadImage)
+    {
+        return false;
+    }
+
+    Define(TextureType::TEX_2D, *m_LoadImage);
+    m_LoadImage.Reset();
+    return m_Handle != 0;
+}
+
 void Texture::Define(TextureType type, const IntV2& size, ImageFormat format, const void* data)
 {
     Define(type, IntV3 {size, 1}, format, data);
@@ -62,7 +85,12 @@ void Texture::Define(TextureType type, const IntV3& size, ImageFormat format, co
 
 void Texture::Define(TextureType type, const SharedPtr<Image>& image)
 {
-    Define(type, image->Size(), image->Format(), image->Data());
+    Define(type, *image);
+}
+
+void Texture::Define(TextureType type, const Image& image)
+{
+    Define(type, image.Size(), image.Format(), image.Data());
 }
 
 void Texture::SetData(const void* data)
@@ -93,25 +121,7 @@ void Texture::Bind(size_t index) const
         return;
     }
 
-    // Already bound
-    if (boundTextureSlot[index] == this)
-    {
-        return;
-    }
-
-    // Unbind previous texture
-    for (auto& slot : boundTextureSlot)
-    {
-        if (slot == this)
-        {
-            slot = nullptr;
-        }
-    }
-
-    glActiveTexture(GL_TEXTURE0 + index);
-    glBindTexture(m_Target, m_Handle);
-
-    boundTextureSlot[index] = this;
+    Graphics::BindTexture(index, m_Target, m_Handle);
 }
 
 void Texture::SetWrapMode(size_t index, TextureWrapMode mode)
@@ -146,14 +156,13 @@ void Texture::SetFilterMode(TextureFilterMode mode)
 
 void Texture::ForceBind() const
 {
-    boundTextureSlot[0] = nullptr;
-    Bind(0);
+    Graphics::BindTextureForUpdate(m_Target, m_Handle);
 }
 
 bool Texture::Create(const void* data)
 {
     glGenTextures(1, &m_Handle);
-    glBindTexture(m_Target, m_Handle);
+    ForceBind();
 
     glTexParameteri(m_Target, GL_TEXTURE_WRAP_S, TextureWrapModeGLType[EnumAsIndex(m_WrapModes[0])]);
     glTexParameteri(m_Target, GL_TEXTURE_WRAP_T, TextureWrapModeGLType[EnumAsIndex(m_WrapModes[1])]);
@@ -199,15 +208,8 @@ void Texture::Release()
     if (m_Handle)
     {
         glDeleteTextures(1, &m_Handle);
+        Graphics::OnTextureDeleted(m_Handle);
         m_Handle = 0;
-        
-        for (size_t i = 0; i < MAX_TEXTURE_SLOTS; ++i)
-        {
-            if (boundTextureSlot[i] == this)
-            {
-                boundTextureSlot[i] = nullptr;
-            }
-        }
     }
 
     m_Target = 0;
@@ -7,12 +7,13 @@
 #include "Math/IntVector.hpp"
 #include "GraphicsDefs.hpp"
 #include "Resource/Image.hpp"
+#include "Resource/Resource.hpp"
 
 namespace Pt {
 
 // TODO: Support resource manager
 /// Texture
-class Texture : public Object
+class Texture : public Resource
 {
     OBJECT(Texture);
 public:
@@ -21,10 +22,16 @@ public:
 
     static void RegisterObject();
 
+    /// Decode the 2D image file given by Name(). Safe on worker threads.
+    virtual bool BeginLoad() override;
+    /// Create the texture from the decoded image. Must run on the graphics thread.
+    virtual bool EndLoad() override;
+
     /// Create texture
     void Define(TextureType type, const IntV2& size, ImageFormat format, const void* data);
     void Define(TextureType type, const IntV3& size, ImageFormat format, const void* data);
     void Define(TextureType type, const SharedPtr<Image>& image);
+    void Define(TextureType type, const Image& image);
     void SetData(const void* data);
     /// Auto bind texture
     void Bind(size_t index) const;
@@ -46,6 +53,7 @@ public:
     /// Get texture GL target
     unsigned GLTarget() const { return m_Target; }
 private:
+    /// Bind to the first unit, to change the texture.
     void ForceBind() const;
 
     bool Create(const void* data);
@@ -62,6 +70,9 @@ private:
     TextureType m_Type;
     TextureWrapMode m_WrapModes[3];
     TextureFilterMode m_FilterMode;
+
+    /// Image decoded by BeginLoad() until EndLoad(). Created on a loader worker, its thread-safe RefCount comes from the shared allocator.
+    ScopedPtr<Image> m_LoadImage;
 };
 
 } // namespace Pt
\ No newline at end of file
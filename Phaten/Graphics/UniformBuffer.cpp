@@ -8,9 +8,6 @@
 
 namespace Pt {
 
-/// Store all uniform buffer binding point.
-static UniformBuffer* boundUniformBuffers[MAX_UNIFORM_BUFFER_SLOTS] {nullptr};
-
 UniformBuffer::UniformBuffer() :
     m_Handle(0),
     m_Usage(BufferUsage::STATIC),
@@ -63,7 +60,7 @@ bool UniformBuffer::SetData(size_t offsetByte, size_t sizeByte, const void *data
 
 
     GLenum usage = m_Usage == BufferUsage::DYNAMIC ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
-    glBindBuffer(GL_UNIFORM_BUFFER, m_Handle);
+    Graphics::BindBuffer(GL_UNIFORM_BUFFER, m_Handle);
     if (sizeByte == m_SizeByte)
     {
         glBufferData(GL_UNIFORM_BUFFER, m_SizeByte, data, usage);
@@ -83,22 +80,17 @@ bool UniformBuffer::SetData(size_t offsetByte, size_t sizeByte, const void *data
 
 void UniformBuffer::Bind(size_t index)
 {
-    if (!m_Handle || boundUniformBuffers[index] == this)
+    if (!m_Handle)
     {
         return;
     }
 
-    glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(index), m_Handle, 0, m_SizeByte);
-    boundUniformBuffers[index] = this;
+    Graphics::BindUniformBuffer(index, m_Handle, m_SizeByte);
 }
 
 void UniformBuffer::Unbind(size_t index)
 {
-    if (boundUniformBuffers[index])
-    {
-        glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(index), 0, 0, 0);
-        boundUniformBuffers[index] = nullptr;
-    }
+    Graphics::BindUniformBuffer(index, 0, 0);
 }
 
 bool UniformBuffer::Create(const void* data)
@@ -110,7 +102,7 @@ bool UniformBuffer::Create(const void* data)
         return false;
     }
 
-    glBindBuffer(GL_UNIFORM_BUFFER, m_Handle);
+    Graphics::BindBuffer(GL_UNIFORM_BUFFER, m_Handle);
     glBufferData(
         GL_UNIFORM_BUFFER,
         m_SizeByte,
@@ -128,15 +120,8 @@ void UniformBuffer::Release()
     if (m_Handle)
     {
         glDeleteBuffers(1, &m_Handle);
+        Graphics::OnBufferDeleted(m_Handle);
         m_Handle = 0;
-
-        for (UniformBuffer* buffer : boundUniformBuffers)
-        {
-            if (buffer == this)
-            {
-                buffer = nullptr;
-            }
-        }
     }
 }
 
@@ -57,6 +57,22 @@ public:
     std::vector<VertexElement>::const_iterator end() const { return m_Elements.end(); }
 
     operator bool () const { return !m_Elements.empty(); }
+
+    bool operator == (const VertexLayout& rhs) const
+    {
+        if (m_Stride != rhs.m_Stride || m_Elements.size() != rhs.m_Elements.size())
+            return false;
+        for (size_t i = 0; i < m_Elements.size(); ++i)
+        {
+            const VertexElement& lhsElement = m_Elements[i];
+            const VertexElement& rhsElement = rhs.m_Elements[i];
+            if (lhsElement.type != rhsElement.type || lhsElement.semantic != rhsElement.semantic ||
+                lhsElement.offset != rhsElement.offset)
+                return false;
+        }
+        return true;
+    }
+    bool operator != (const VertexLayout& rhs) const { return !(*this == rhs); }
 private:
     void CalculateStride()
     {
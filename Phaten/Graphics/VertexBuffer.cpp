@@ -8,16 +8,36 @@
 
 namespace Pt {
 
-static unsigned boundVertexAttributes  = 0;
-static VertexBuffer* boundVertexBuffer = nullptr;
-/// Pointer to vertex buffer whose attributes are being using.
-static VertexBuffer* boundVertexAttributeSource = nullptr;
+static const size_t MAX_VERTEX_ATTRIBUTES = EnumAsIndex(VertexAttributeType::MAX_ATTRIBUTE);
+
+// Attribute state of the default vertex array, cached vertex arrays keep their own.
+/// Enabled vertex attributes.
+static unsigned enabledVertexAttributes = 0;
+/// Vertex buffer each attribute reads from.
+static VertexBuffer* vertexAttributeSources[MAX_VERTEX_ATTRIBUTES] = { nullptr };
+/// Instance divisor of each attribute.
+static unsigned vertexAttributeDivisors[MAX_VERTEX_ATTRIBUTES] = { 0 };
+
+/// Point an attribute at an element of the bound array buffer.
+static void AttributePointer(unsigned attributeIdx, const VertexElement& element, size_t stride)
+{
+    size_t typeAsIdx = EnumAsIndex(element.type);
+    glVertexAttribPointer(
+        attributeIdx,
+        VertexElementGLCount[typeAsIdx],
+        VertexElementGLType[typeAsIdx],
+        element.semantic == VertexElementSemantic::VERTEX_COLOR ? GL_TRUE : GL_FALSE,
+        stride,
+        reinterpret_cast<void*>(element.offset)
+    );
+}
 
 VertexBuffer::VertexBuffer() :
     m_Handle(0),
     m_Usage(BufferUsage::STATIC),
     m_NumVertices(0),
-    m_Attributes(0)
+    m_Attributes(0),
+    m_PerInstance(false)
 {
     PT_ASSERT_MSG(Object::Subsystem<Graphics>()->IsInitialized(), "Graphics system not loaded");
 }
@@ -99,37 +119,19 @@ void VertexBuffer::Bind(unsigned int attributeMask)
     {
         return;
     }
-    // This 0 condition is only for creating vertex buffer
-    // bescase glBufferData needs this buffer being bound. 
+    // Ensure binding for later operations, glBufferData needs it.
+    Graphics::BindBuffer(GL_ARRAY_BUFFER, m_Handle);
+    // This 0 condition is only for creating vertex buffer.
     // Just bind and return.
     if (!attributeMask)
-    {
-        if (boundVertexBuffer != this)
-        {
-            glBindBuffer(GL_ARRAY_BUFFER, m_Handle);
-            boundVertexBuffer = this;
-        }
-        return;
-    }
-
-    // Filter attributes which don't have.
-    attributeMask &= m_Attributes;
-
-    // Return if has been bound
-    if (attributeMask == boundVertexAttributes 
-        && boundVertexAttributeSource == this)
     {
         return;
     }
-    // Ensure binding for later operations.
-    if (boundVertexBuffer != this)
-    {
-        glBindBuffer(GL_ARRAY_BUFFER, m_Handle);
-        boundVertexBuffer = this;
-    }
 
-    unsigned usedAttributes = 0;
+    // The attribute state above belongs to the default vertex array.
+    Graphics::BindDefaultVertexArray();
 
+    unsigned divisor = m_PerInstance ? 1 : 0;
     for (const VertexElement& element : m_Layout)
     {
         unsigned attributeIdx = VertexAttributeIdx[EnumAsIndex(element.semantic)];
@@ -141,26 +143,28 @@ void VertexBuffer::Bind(unsigned int attributeMask)
         }
 
         /// Enable attribute if not has been set before
-        if (!(boundVertexAttributes & attributeBit))
+        if (!(enabledVertexAttributes & attributeBit))
         {
             glEnableVertexAttribArray(attributeIdx);
+            enabledVertexAttributes |= attributeBit;
         }
 
-        size_t typeAsIdx = EnumAsIndex(element.type);
-        glVertexAttribPointer(
-            attributeIdx,
-            VertexElementGLCount[typeAsIdx],
-            VertexElementGLType[typeAsIdx],
-            element.semantic == VertexElementSemantic::VERTEX_COLOR ? GL_TRUE : GL_FALSE,
-            m_Layout.Stride(),
-            reinterpret_cast<void*>(element.offset)
-        );
+        // Pointers are kept until another buffer sources the attribute.
+        if (vertexAttributeSources[attributeIdx] != this)
+        {
+            AttributePointer(attributeIdx, element, m_Layout.Stride());
+            vertexAttributeSources[attributeIdx] = this;
+        }
 
-        usedAttributes |= attributeBit; // Only contains enabled atrributes.
+        if (vertexAttributeDivisors[attributeIdx] != divisor)
+        {
+            glVertexAttribDivisor(attributeIdx, divisor);
+            vertexAttributeDivisors[attributeIdx] = divisor;
+        }
     }
 
-    // Disable unused attributes.
-    unsigned disabledAttributes = boundVertexAttributes & (~usedAttributes); // Bits.
+    // Disable attributes outside the mask. Attributes of other buffers in the mask stay enabled.
+    unsigned disabledAttributes = enabledVertexAttributes & (~attributeMask); // Bits.
     unsigned disableIdx = 0; // Decimal.
 
     // Traverse
@@ -176,9 +180,32 @@ void VertexBuffer::Bind(unsigned int attributeMask)
     }
 
     // Update bound state.
-    boundVertexAttributes = usedAttributes;
-    boundVertexBuffer = this;
-    boundVertexAttributeSource = this;
+    enabledVertexAttributes &= attributeMask;
+}
+
+void VertexBuffer::SpecifyAttributes(unsigned attributeMask)
+{
+    if (!m_Handle)
+    {
+        return;
+    }
+    Graphics::BindBuffer(GL_ARRAY_BUFFER, m_Handle);
+
+    for (const VertexElement& element : m_Layout)
+    {
+        unsigned attributeIdx = VertexAttributeIdx[EnumAsIndex(element.semantic)];
+        if (!(attributeMask & (1 << attributeIdx)))
+        {
+            continue;
+        }
+
+        glEnableVertexAttribArray(attributeIdx);
+        AttributePointer(attributeIdx, element, m_Layout.Stride());
+        if (m_PerInstance)
+        {
+            glVertexAttribDivisor(attributeIdx, 1);
+        }
+    }
 }
 
 // Called by Define() only.
@@ -209,15 +236,15 @@ void VertexBuffer::Release()
     if (m_Handle)
     {
         glDeleteBuffers(1, &m_Handle);
+        Graphics::OnBufferDeleted(m_Handle);
         m_Handle = 0;
 
-        if (boundVertexBuffer == this)
-        {
-            boundVertexBuffer = nullptr;
-        }
-        if (boundVertexAttributeSource == this)
+        for (VertexBuffer*& source : vertexAttributeSources)
         {
-            boundVertexAttributeSource = nullptr;
+            if (source == this)
+            {
+                source = nullptr;
+            }
         }
     }
 }
@@ -17,9 +17,14 @@ public:
     bool Define(BufferUsage usage, size_t numVertices, const VertexLayout& layout, const void* data = nullptr);
     /// Update buffer data, dicard means discard all old data.
     bool SetData(size_t startIdx, size_t numbVertices, const void* data, bool discard = false);
-    /// Bind certain attributes
+    /// Bind certain attributes. Enabled attributes outside the mask are disabled, so pass the same mask to every buffer of a draw.
     /// Do not use 0.
     void Bind(unsigned attributeMask);
+    /// Enable and point attributes in the mask at this buffer in the bound vertex array, which must be new.
+    /// Used by Graphics::BindGeometry() to fill cached vertex arrays.
+    void SpecifyAttributes(unsigned attributeMask);
+    /// Advance attributes once per instance instead of once per vertex. Set before the buffer is first drawn.
+    void SetPerInstance(bool enable) { m_PerInstance = enable; }
 
     /// Get OpenGL object identifier
     unsigned GLHandle() const { return m_Handle; }
@@ -27,6 +32,7 @@ public:
     bool IsDynamic() const { return m_Usage == BufferUsage::DYNAMIC; }
     size_t NumVertices() const { return m_NumVertices; }
     unsigned Attributes() const { return m_Attributes; } 
+    bool IsPerInstance() const { return m_PerInstance; }
 
     /// Use buffer layout to calculate enabled attributes to a mask
     static unsigned CalculateAttributesMask(const VertexLayout& layout);
@@ -46,6 +52,8 @@ private:
     VertexLayout m_Layout;
     /// Enbabled vertex attributes
     unsigned m_Attributes;
+    /// Attributes advance per instance.
+    bool m_PerInstance;
 };
 
 } // namespace Pt
\ No newline at end of file
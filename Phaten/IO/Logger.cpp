@@ -0,0 +1,175 @@
+#include "Logger.hpp"
+
+#include <chrono>
+
+namespace Pt {
+
+/// Records written before the stream is flushed and Flush() waiters are released.
+static const size_t LOG_WRITE_BATCH = 256;
+
+namespace detail {
+
+LogQueue::LogQueue(size_t capacity) :
+    enqueuePos_(0),
+    dequeuePos_(0)
+{
+    // Round up to a power of two so positions map to cells with a mask.
+    size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+
+    cells_ = std::vector<Cell>(size);
+    for (size_t i = 0; i < size; ++i)
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    mask_ = size - 1;
+}
+
+bool LogQueue::TryPush(const LogRecord& record)
+{
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell& cell = cells_[pos & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            // Free for this position, claim it.
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                cell.record = record;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+            return false;
+        else
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+    }
+}
+
+bool LogQueue::TryPop(LogRecord& record)
+{
+    size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[pos & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+        return false;
+
+    record = cell.record;
+    // Free the cell for the producer one lap later.
+    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+AsyncLogWriter::AsyncLogWriter(std::ostream& stream, size_t capacity) :
+    stream_(stream),
+    queue_(capacity),
+    written_(0),
+    idle_(false),
+    stop_(false)
+{
+    thread_ = std::thread([this]() { ThreadFunction(); });
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wakeup_.notify_one();
+    thread_.join();
+}
+
+void AsyncLogWriter::Push(const LogRecord& record)
+{
+    // Waiting only happens when the thread falls a whole queue behind.
+    while (!queue_.TryPush(record))
+    {
+        wakeup_.notify_one();
+        std::this_thread::yield();
+    }
+
+    if (idle_.load())
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wakeup_.notify_one();
+    }
+}
+
+void AsyncLogWriter::Flush()
+{
+    size_t target = queue_.Pushed();
+    while (written_.load(std::memory_order_acquire) < target)
+    {
+        wakeup_.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+void AsyncLogWriter::ThreadFunction()
+{
+    LogRecord record;
+    size_t written = 0;
+    for (;;)
+    {
+        size_t batch = 0;
+        while (batch < LOG_WRITE_BATCH && queue_.TryPop(record))
+        {
+            WriteLogHeader(stream_, record.level, record.fileName, record.function, record.line);
+            record.format(stream_, record);
+            stream_ << "\n";
+            ++batch;
+        }
+
+        if (batch)
+        {
+            stream_.flush();
+            written += batch;
+            written_.store(written, std::memory_order_release);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stop_)
+            break;
+
+        // Check again after announcing, a producer that missed the flag pushed before it.
+        idle_.store(true);
+        if (queue_.Pushed() == written)
+        {
+            // The timeout bounds the delay if a wakeup is missed anyway.
+            wakeup_.wait_for(lock, std::chrono::milliseconds(10));
+        }
+        idle_.store(false);
+    }
+}
+
+} // namespace detail
+
+void Logger::SetAsync(bool enable, size_t capacity)
+{
+    if (enable == IsAsync())
+        return;
+
+    if (enable)
+        async_ = new detail::AsyncLogWriter(stream_, capacity);
+    else
+    {
+        // The destructor writes the remaining records.
+        delete async_;
+        async_ = nullptr;
+    }
+}
+
+void Logger::Flush()
+{
+    if (async_)
+        async_->Flush();
+    else
+        stream_.flush();
+}
+
+} // namespace Pt
\ No newline at end of file
@@ -1,11 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <cassert>
 #include <iostream>
 #include <functional>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "Core/Core.hpp"
 #include "Object/Ptr.hpp"
@@ -24,6 +33,9 @@ enum class Level
     Fatal,
 };
 
+static_assert(static_cast<int>(Level::Debug) == PT_LOG_LEVEL_DEBUG && static_cast<int>(Level::Fatal) == PT_LOG_LEVEL_FATAL,
+    "Level values must match PT_LOG_LEVEL_*");
+
 static const std::string_view LevelToString(Level level)
 {
     switch (level)
@@ -38,74 +50,266 @@ static const std::string_view LevelToString(Level level)
     }
 }
 
+/// Write level and, unless compact, location of a log line.
+inline void WriteLogHeader(std::ostream& stream, Level level, const char* fileName, const char* function, uint32_t line)
+{
+    stream << LevelToString(level) << " ";
+#ifndef PT_LOGGING_COMPACT
+    stream << fileName << ":" << line << ":" << function << "\n" << ">> ";
+#else
+    (void)fileName;
+    (void)function;
+    (void)line;
+#endif
+}
+
+#define DEFAULT_LOG_QUEUE_CAPACITY 1024
+
+namespace detail {
+
+/// Fixed-size log line passed from callers to the logger thread. Arguments are formatted by the logger thread.
+struct LogRecord
+{
+    static constexpr size_t PAYLOAD_SIZE = 200;
+
+    Level level;
+    uint32_t line;
+    /// Static strings from __FILE__ and __FUNCTION__.
+    const char* fileName;
+    const char* function;
+    /// Decode and write the payload, instantiated for the argument types.
+    void (*format)(std::ostream& stream, const LogRecord& record);
+    /// Arguments stored, the last one may be cut short.
+    uint16_t numArgs;
+    uint16_t payloadUsed;
+    bool truncated;
+    unsigned char payload[PAYLOAD_SIZE];
+};
+
+/// Numbers are stored as is, everything else as text.
+template <typename T>
+constexpr bool IsLogNumber = std::is_arithmetic_v<std::decay_t<T>>;
+
+/// Store a 16-bit length and as many characters as fit. Return false if cut short.
+inline bool EncodeLogText(LogRecord& record, std::string_view text)
+{
+    size_t space = LogRecord::PAYLOAD_SIZE - record.payloadUsed;
+    if (space < sizeof(uint16_t))
+        return false;
+
+    uint16_t length = static_cast<uint16_t>(std::min(text.size(), space - sizeof(uint16_t)));
+    memcpy(record.payload + record.payloadUsed, &length, sizeof(length));
+    memcpy(record.payload + record.payloadUsed + sizeof(length), text.data(), length);
+    record.payloadUsed += sizeof(length) + length;
+    ++record.numArgs;
+    return length == text.size();
+}
+
+/// Copy an argument into the record. Strings are copied, since the caller's buffer may be gone when the record is written.
+/// Types that are neither numbers nor strings are formatted right away. Return false if cut short.
+template <typename T>
+bool EncodeLogArg(LogRecord& record, const T& arg)
+{
+    if constexpr (IsLogNumber<T>)
+    {
+        std::decay_t<T> value = arg;
+        if (record.payloadUsed + sizeof(value) > LogRecord::PAYLOAD_SIZE)
+            return false;
+
+        memcpy(record.payload + record.payloadUsed, &value, sizeof(value));
+        record.payloadUsed += sizeof(value);
+        ++record.numArgs;
+        return true;
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        return EncodeLogText(record, std::string_view(arg));
+    else
+    {
+        std::ostringstream text;
+        text << arg;
+        return EncodeLogText(record, text.str());
+    }
+}
+
+template <typename T>
+void DecodeLogArg(std::ostream& stream, const unsigned char*& payload)
+{
+    if constexpr (IsLogNumber<T>)
+    {
+        std::decay_t<T> value;
+        memcpy(&value, payload, sizeof(value));
+        payload += sizeof(value);
+        stream << value;
+    }
+    else
+    {
+        uint16_t length;
+        memcpy(&length, payload, sizeof(length));
+        stream.write(reinterpret_cast<const char*>(payload + sizeof(length)), length);
+        payload += sizeof(length) + length;
+    }
+}
+
+template <typename... Args>
+void FormatLogRecord(std::ostream& stream, const LogRecord& record)
+{
+    const unsigned char* payload = record.payload;
+    unsigned index = 0;
+    ((index++ < record.numArgs ? DecodeLogArg<Args>(stream, payload) : void()), ...);
+    if (record.truncated)
+        stream << "...";
+}
+
+/// Bounded lock-free queue of log records, many producers and one consumer.
+/// Each cell has a sequence number telling whether it is free for the producer at a position or filled for the consumer.
+class LogQueue
+{
+public:
+    explicit LogQueue(size_t capacity);
+
+    /// Return false if full.
+    bool TryPush(const LogRecord& record);
+    /// Only called by the consumer. Return false if empty.
+    bool TryPop(LogRecord& record);
+    /// Return number of records pushed so far.
+    size_t Pushed() const { return enqueuePos_.load(std::memory_order_acquire); }
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    std::vector<Cell> cells_;
+    size_t mask_;
+    /// Written by producers and the consumer, kept on separate cache lines.
+    alignas(64) std::atomic<size_t> enqueuePos_;
+    alignas(64) std::atomic<size_t> dequeuePos_;
+};
+
+/// Background thread writing queued records to a stream.
+class AsyncLogWriter
+{
+public:
+    AsyncLogWriter(std::ostream& stream, size_t capacity);
+    /// Write remaining records and stop the thread.
+    ~AsyncLogWriter();
+
+    /// Queue a record. Waits for space if the queue is full.
+    void Push(const LogRecord& record);
+    /// Block until records queued before the call are written and the stream flushed.
+    void Flush();
+private:
+    void ThreadFunction();
+
+    std::ostream& stream_;
+    LogQueue queue_;
+    /// Records written and flushed.
+    std::atomic<size_t> written_;
+    /// Set while the thread waits for records.
+    std::atomic<bool> idle_;
+    bool stop_;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::thread thread_;
+};
+
+} // namespace detail
+
 /// Manage loggering to a certain stream.
 /// Notice that stream can not change once been set.
 class Logger final : public RefCounted
 {
 public:
     Logger(std::ostream& stream, Level level = Level::None, std::function<void(void)> createFn = nullptr)
-    : stream_(stream), level_(level)
+    : stream_(stream), level_(level), async_(nullptr)
     {
         if (createFn) createFn();
     }
 
     ~Logger()
     {
+        SetAsync(false);
         if (destoryFn_) destoryFn_();
     }
 
     void SetLevel(Level level) { level_ = level; }
     Level GetLevel() const { return level_; }
+    /// Return whether records of level are written.
+    bool IsEnabled(Level level) const { return level >= level_; }
+
+    /// Queue records and write them on a background thread, so callers do not wait for the stream.
+    /// Fatal records are flushed before returning. Not thread-safe with logging calls.
+    void SetAsync(bool enable, size_t capacity = DEFAULT_LOG_QUEUE_CAPACITY);
+    bool IsAsync() const { return async_ != nullptr; }
+    /// Block until queued records are written.
+    void Flush();
 
     /// Set custom destory callback.
     void SetDestoryCallback(std::function<void()> fn) { destoryFn_ = fn; }
 
     template <typename... Args>
-    void Debug(std::string_view fileName, std::string function, uint32_t line, Args&&... args)
+    void Debug(const char* fileName, const char* function, uint32_t line, Args&&... args)
     {
         LogImpl(Level::Debug, fileName, function, line, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void Trace(std::string_view fileName, std::string function, uint32_t line, Args&&... args)
+    void Trace(const char* fileName, const char* function, uint32_t line, Args&&... args)
     {
         LogImpl(Level::Trace, fileName, function, line, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void Info(std::string_view fileName, std::string function, uint32_t line, Args&&... args)
+    void Info(const char* fileName, const char* function, uint32_t line, Args&&... args)
     {
         LogImpl(Level::Info, fileName, function, line, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void Warn(std::string_view fileName, std::string function, uint32_t line, Args&&... args)
+    void Warn(const char* fileName, const char* function, uint32_t line, Args&&... args)
     {
         LogImpl(Level::Warn, fileName, function, line, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void Error(std::string_view fileName, std::string function, uint32_t line, Args&&... args)
+    void Error(const char* fileName, const char* function, uint32_t line, Args&&... args)
     {
         LogImpl(Level::Error, fileName, function, line, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void Fatal(std::string_view fileName, std::string function, uint32_t line, Args&&... args)
+    void Fatal(const char* fileName, const char* function, uint32_t line, Args&&... args)
     {
         LogImpl(Level::Fatal, fileName, function, line, std::forward<Args>(args)...);
     }
 private:
     template <typename... Args>
-    void LogImpl(Level level, std::string_view fileName, std::string funcName, uint32_t line, Args&&... args)
+    void LogImpl(Level level, const char* fileName, const char* funcName, uint32_t line, Args&&... args)
     {
         // filter out low level logs
-        if (level < level_) return;
+        if (!IsEnabled(level)) return;
 
-        stream_ << LevelToString(level) << " ";
-#ifndef PT_LOGGING_COMPACT
-        stream_ << fileName << ":" << line << ":" << funcName << "\n" << ">> ";
-#endif
+        if (async_)
+        {
+            detail::LogRecord record;
+            record.level = level;
+            record.line = line;
+            record.fileName = fileName;
+            record.function = funcName;
+            record.format = &detail::FormatLogRecord<std::decay_t<Args>...>;
+            record.numArgs = 0;
+            record.payloadUsed = 0;
+            bool complete = true;
+            ((complete = complete && detail::EncodeLogArg(record, args)), ...);
+            record.truncated = !complete;
+
+            async_->Push(record);
+            if (level == Level::Fatal) async_->Flush();
+            return;
+        }
+
+        WriteLogHeader(stream_, level, fileName, funcName, line);
         doLogImpl(std::forward<Args>(args)...);
         stream_ << "\n";
     }
@@ -125,6 +329,8 @@ private:
 private:
     std::ostream& stream_;
     Level level_;
+    /// Null unless async.
+    detail::AsyncLogWriter* async_;
 
     std::function<void()> destoryFn_; 
 };
@@ -134,6 +340,11 @@ class LoggerManager final : public RefCounted
 public:
     LoggerManager() {
         defaultLogger_ = CreateShared<Logger>(std::cout);
+        sDefaultLogger = defaultLogger_.Get();
+    }
+
+    ~LoggerManager() {
+        sDefaultLogger = nullptr;
     }
 
     static LoggerManager& Instance() {
@@ -144,6 +355,9 @@ public:
         return *instance;
     }
 
+    /// Return whether the default logger writes level, without touching the instance once it exists.
+    static bool IsDefaultEnabled(Level level) { return !sDefaultLogger || sDefaultLogger->IsEnabled(level); }
+
     Logger& GetDefaultLogger() { return *defaultLogger_; }
     const Logger& GetDefault() const { return *defaultLogger_; }
 
@@ -161,23 +375,34 @@ public:
     const Logger& GetLogger(const std::string& name) const { return *loggers_.at(name); }
 private:
     SharedPtr<Logger> defaultLogger_;
+    /// Default logger of the instance, null before it is created.
+    inline static Logger* sDefaultLogger = nullptr;
     std::unordered_map<std::string, SharedPtr<Logger>> loggers_;
 };
 
 #ifdef PT_ENABLE_LOGGING
-    #define PT_LOG_DEBUG(...) ::Pt::LoggerManager::Instance().GetDefaultLogger().Debug(__FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
-    #define PT_LOG_TRACE(...) ::Pt::LoggerManager::Instance().GetDefaultLogger().Trace(__FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
-    #define PT_LOG_INFO(...)  ::Pt::LoggerManager::Instance().GetDefaultLogger().Info(__FILE__,  __FUNCTION__, __LINE__, __VA_ARGS__)
-    #define PT_LOG_WARN(...)  ::Pt::LoggerManager::Instance().GetDefaultLogger().Warn(__FILE__,  __FUNCTION__, __LINE__, __VA_ARGS__)
-    #define PT_LOG_ERROR(...) ::Pt::LoggerManager::Instance().GetDefaultLogger().Error(__FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
-    #define PT_LOG_FATAL(...) ::Pt::LoggerManager::Instance().GetDefaultLogger().Fatal(__FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
-
-    #define PT_TAG_DEBUG(tag, ...) ::Pt::LoggerManager::Instance().GetDefaultLogger().Debug(__FILE__, __FUNCTION__, __LINE__, "\x1b[32m[", tag "]\x1b[0m ", __VA_ARGS__)
-    #define PT_TAG_TRACE(tag, ...) ::Pt::LoggerManager::Instance().GetDefaultLogger().Trace(__FILE__, __FUNCTION__, __LINE__, "\x1b[35m[", tag "]\x1b[0m ", __VA_ARGS__)
-    #define PT_TAG_INFO(tag, ...)  ::Pt::LoggerManager::Instance().GetDefaultLogger().Info(__FILE__,  __FUNCTION__, __LINE__, "\x1b[35m[", tag "]\x1b[0m ", __VA_ARGS__)
-    #define PT_TAG_WARN(tag, ...)  ::Pt::LoggerManager::Instance().GetDefaultLogger().Warn(__FILE__,  __FUNCTION__, __LINE__, "\x1b[35m[", tag "]\x1b[0m ", __VA_ARGS__)
-    #define PT_TAG_ERROR(tag, ...) ::Pt::LoggerManager::Instance().GetDefaultLogger().Error(__FILE__, __FUNCTION__, __LINE__, "\x1b[35m[", tag "]\x1b[0m ", __VA_ARGS__)
-    #define PT_TAG_FATAL(tag, ...) ::Pt::LoggerManager::Instance().GetDefaultLogger().Fatal(__FILE__, __FUNCTION__, __LINE__, "\x1b[35m[", tag "]\x1b[0m ", __VA_ARGS__)
+    /// Log to the default logger. Below PT_LOG_MIN_LEVEL no code is generated, below the runtime level the arguments are not evaluated.
+    #define PT_LOG_IMPL(level, ...) \
+        do { \
+            if constexpr (static_cast<int>(::Pt::Level::level) >= PT_LOG_MIN_LEVEL) { \
+                if (::Pt::LoggerManager::IsDefaultEnabled(::Pt::Level::level)) \
+                    ::Pt::LoggerManager::Instance().GetDefaultLogger().level(__FILE__, __FUNCTION__, __LINE__, __VA_ARGS__); \
+            } \
+        } while (false)
+
+    #define PT_LOG_DEBUG(...) PT_LOG_IMPL(Debug, __VA_ARGS__)
+    #define PT_LOG_TRACE(...) PT_LOG_IMPL(Trace, __VA_ARGS__)
+    #define PT_LOG_INFO(...)  PT_LOG_IMPL(Info, __VA_ARGS__)
+    #define PT_LOG_WARN(...)  PT_LOG_IMPL(Warn, __VA_ARGS__)
+    #define PT_LOG_ERROR(...) PT_LOG_IMPL(Error, __VA_ARGS__)
+    #define PT_LOG_FATAL(...) PT_LOG_IMPL(Fatal, __VA_ARGS__)
+
+    #define PT_TAG_DEBUG(tag, ...) PT_LOG_IMPL(Debug, "\x1b[32m[", tag "]\x1b[0m ", __VA_ARGS__)
+    #define PT_TAG_TRACE(tag, ...) PT_LOG_IMPL(Trace, "\x1b[35m[", tag "]\x1b[0m ", __VA_ARGS__)
+    #define PT_TAG_INFO(tag, ...)  PT_LOG_IMPL(Info, "\x1b[35m[", tag "]\x1b[0m ", __VA_ARGS__)
+    #define PT_TAG_WARN(tag, ...)  PT_LOG_IMPL(Warn, "\x1b[35m[", tag "]\x1b[0m ", __VA_ARGS__)
+    #define PT_TAG_ERROR(tag, ...) PT_LOG_IMPL(Error, "\x1b[35m[", tag "]\x1b[0m ", __VA_ARGS__)
+    #define PT_TAG_FATAL(tag, ...) PT_LOG_IMPL(Fatal, "\x1b[35m[", tag "]\x1b[0m ", __VA_ARGS__)
 #else
     #define PT_LOG_DEBUG(...)
     #define PT_LOG_TRACE(...)
@@ -1,5 +1,392 @@
 #include "Stream.hpp"
 
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 namespace Pt {
 
+/// Size of the FileStream buffer.
+static const size_t FILE_BUFFER_SIZE = 64 * 1024;
+/// Mapped by empty files, which can not be mapped.
+static const unsigned char EMPTY_FILE_DATA[1] = { 0 };
+
+std::string Stream::ReadString()
+{
+    uint32_t length = ReadValue<uint32_t>();
+    std::string ret(std::min<size_t>(length, m_Size - std::min(m_Position, m_Size)), '\0');
+    ret.resize(Read(ret.data(), ret.size()));
+    return ret;
+}
+
+bool Stream::WriteString(std::string_view str)
+{
+    return WriteValue(static_cast<uint32_t>(str.size())) && Write(str.data(), str.size()) == str.size();
+}
+
+std::string Stream::ReadAll()
+{
+    std::string ret(m_Size - std::min(m_Position, m_Size), '\0');
+    ret.resize(Read(ret.data(), ret.size()));
+    return ret;
+}
+
+MemoryStream::MemoryStream() :
+    m_Data(nullptr),
+    m_ReadOnly(true)
+{
+}
+
+MemoryStream::MemoryStream(const void* data, size_t size) :
+    m_Data(static_cast<unsigned char*>(const_cast<void*>(data))),
+    m_ReadOnly(true)
+{
+    m_Size = data ? size : 0;
+}
+
+MemoryStream::MemoryStream(void* data, size_t size) :
+    m_Data(static_cast<unsigned char*>(data)),
+    m_ReadOnly(false)
+{
+    m_Size = data ? size : 0;
+}
+
+size_t MemoryStream::Read(void* dest, size_t size)
+{
+    size = std::min(size, m_Size - std::min(m_Position, m_Size));
+    if (size)
+        memcpy(dest, m_Data + m_Position, size);
+    m_Position += size;
+    return size;
+}
+
+size_t MemoryStream::Write(const void* data, size_t size)
+{
+    if (m_ReadOnly)
+        return 0;
+
+    size = std::min(size, m_Size - std::min(m_Position, m_Size));
+    if (size)
+        memcpy(m_Data + m_Position, data, size);
+    m_Position += size;
+    return size;
+}
+
+size_t MemoryStream::Seek(size_t position)
+{
+    m_Position = std::min(position, m_Size);
+    return m_Position;
+}
+
+MappedFileStream::MappedFileStream()
+#ifdef _WIN32
+    : m_File(nullptr),
+    m_Mapping(nullptr)
+#endif
+{
+}
+
+MappedFileStream::MappedFileStream(std::string_view path) :
+    MappedFileStream()
+{
+    Open(path);
+}
+
+MappedFileStream::~MappedFileStream()
+{
+    Close();
+}
+
+bool MappedFileStream::Open(std::string_view path)
+{
+    Close();
+
+    std::string fileName(path);
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    m_File = file;
+    m_Size = static_cast<size_t>(fileSize.QuadPart);
+    if (!m_Size)
+    {
+        m_Data = const_cast<unsigned char*>(EMPTY_FILE_DATA);
+        return true;
+    }
+
+    m_Mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* data = m_Mapping ? MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!data)
+    {
+        Close();
+        return false;
+    }
+#else
+    int file = open(fileName.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+    {
+        close(file);
+        return false;
+    }
+
+    m_Size = static_cast<size_t>(fileStat.st_size);
+    if (!m_Size)
+    {
+        close(file);
+        m_Data = const_cast<unsigned char*>(EMPTY_FILE_DATA);
+        return true;
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+    {
+        m_Size = 0;
+        return false;
+    }
+#endif
+
+    m_Data = static_cast<unsigned char*>(data);
+    m_Position = 0;
+    return true;
+}
+
+void MappedFileStream::Close()
+{
+    if (m_Data && m_Data != EMPTY_FILE_DATA)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_Data);
+#else
+        munmap(m_Data, m_Size);
+#endif
+    }
+
+#ifdef _WIN32
+    if (m_Mapping)
+        CloseHandle(m_Mapping);
+    if (m_File)
+        CloseHandle(m_File);
+    m_Mapping = nullptr;
+    m_File = nullptr;
+#endif
+
+    m_Data = nullptr;
+    m_Size = 0;
+    m_Position = 0;
+}
+
+FileStream::FileStream() :
+    m_Handle(nullptr),
+    m_Mode(FileMode::READ),
+    m_BufferOffset(0),
+    m_BufferUsed(0),
+    m_HandlePosition(0)
+{
+}
+
+FileStream::FileStream(std::string_view path, FileMode mode) :
+    FileStream()
+{
+    Open(path, mode);
+}
+
+FileStream::~FileStream()
+{
+    Close();
+}
+
+bool FileStream::Open(std::string_view path, FileMode mode)
+{
+    Close();
+
+    std::string fileName(path);
+    m_Handle = fopen(fileName.c_str(), mode == FileMode::READ ? "rb" : "wb");
+    if (!m_Handle)
+        return false;
+
+    // Buffered here, the C library buffer would only add a copy.
+    setvbuf(m_Handle, nullptr, _IONBF, 0);
+
+    m_Mode = mode;
+    m_Position = 0;
+    m_Size = 0;
+    m_BufferOffset = 0;
+    m_BufferUsed = 0;
+    m_HandlePosition = 0;
+
+    if (mode == FileMode::READ)
+    {
+        if (!SeekHandle(SIZE_MAX))
+        {
+            Close();
+            return false;
+        }
+        m_Size = m_HandlePosition;
+    }
+
+    return true;
+}
+
+void FileStream::Close()
+{
+    if (!m_Handle)
+        return;
+
+    Flush();
+    fclose(m_Handle);
+    m_Handle = nullptr;
+    m_Position = 0;
+    m_Size = 0;
+    m_BufferUsed = 0;
+}
+
+void FileStream::Flush()
+{
+    if (!m_Handle || m_Mode != FileMode::WRITE || !m_BufferUsed)
+        return;
+
+    if (SeekHandle(m_BufferOffset))
+        m_HandlePosition += fwrite(m_Buffer.data(), 1, m_BufferUsed, m_Handle);
+    m_BufferUsed = 0;
+}
+
+size_t FileStream::Read(void* dest, size_t size)
+{
+    if (!m_Handle || m_Mode != FileMode::READ)
+        return 0;
+
+    size = std::min(size, m_Size - std::min(m_Position, m_Size));
+    unsigned char* out = static_cast<unsigned char*>(dest);
+    size_t remaining = size;
+    while (remaining)
+    {
+        // Copy what the buffer already holds.
+        if (m_Position >= m_BufferOffset && m_Position < m_BufferOffset + m_BufferUsed)
+        {
+            size_t offset = m_Position - m_BufferOffset;
+            size_t count = std::min(remaining, m_BufferUsed - offset);
+            memcpy(out, m_Buffer.data() + offset, count);
+            out += count;
+            m_Position += count;
+            remaining -= count;
+            continue;
+        }
+
+        if (!SeekHandle(m_Position))
+            break;
+
+        // Large reads and reads to the end skip the buffer, reading a whole file is a single call.
+        if (remaining >= FILE_BUFFER_SIZE || m_Position + remaining == m_Size)
+        {
+            size_t count = fread(out, 1, remaining, m_Handle);
+            m_HandlePosition += count;
+            m_Position += count;
+            remaining -= count;
+            break;
+        }
+
+        m_Buffer.resize(FILE_BUFFER_SIZE);
+        m_BufferOffset = m_Position;
+        m_BufferUsed = fread(m_Buffer.data(), 1, m_Buffer.size(), m_Handle);
+        m_HandlePosition += m_BufferUsed;
+        if (!m_BufferUsed)
+            break;
+    }
+
+    return size - remaining;
+}
+
+size_t FileStream::Write(const void* data, size_t size)
+{
+    if (!m_Handle || m_Mode != FileMode::WRITE)
+        return 0;
+
+    // Pending bytes must be contiguous with the position.
+    if (m_BufferUsed && m_Position != m_BufferOffset + m_BufferUsed)
+        Flush();
+    if (!m_BufferUsed)
+        m_BufferOffset = m_Position;
+
+    size_t written = 0;
+    if (m_BufferUsed + size <= FILE_BUFFER_SIZE)
+    {
+        m_Buffer.resize(FILE_BUFFER_SIZE);
+        memcpy(m_Buffer.data() + m_BufferUsed, data, size);
+        m_BufferUsed += size;
+        written = size;
+    }
+    else
+    {
+        Flush();
+        if (SeekHandle(m_Position))
+        {
+            written = fwrite(data, 1, size, m_Handle);
+            m_HandlePosition += written;
+        }
+    }
+
+    m_Position += written;
+    m_Size = std::max(m_Size, m_Position);
+    return written;
+}
+
+size_t FileStream::Seek(size_t position)
+{
+    if (!m_Handle)
+        return 0;
+
+    if (m_Mode == FileMode::READ)
+        position = std::min(position, m_Size);
+    m_Position = position;
+    return m_Position;
+}
+
+bool FileStream::SeekHandle(size_t position)
+{
+    if (position == m_HandlePosition)
+        return true;
+
+    // SIZE_MAX seeks to the end, used to find the size.
+#ifdef _WIN32
+    bool success = position == SIZE_MAX ? _fseeki64(m_Handle, 0, SEEK_END) == 0 :
+        _fseeki64(m_Handle, static_cast<__int64>(position), SEEK_SET) == 0;
+    __int64 current = _ftelli64(m_Handle);
+#else
+    bool success = position == SIZE_MAX ? fseeko(m_Handle, 0, SEEK_END) == 0 :
+        fseeko(m_Handle, static_cast<off_t>(position), SEEK_SET) == 0;
+    off_t current = ftello(m_Handle);
+#endif
+    if (current >= 0)
+        m_HandlePosition = static_cast<size_t>(current);
+    return success && current >= 0;
+}
+
 } // namespace Pt
\ No newline at end of file
@@ -1,10 +1,153 @@
 #pragma once
 
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
 namespace Pt {
 
+enum class FileMode
+{
+    READ,
+    WRITE
+};
+
+/// Base class of binary streams. Read() and Write() return the number of bytes transferred.
 class Stream
 {
+public:
+    Stream() :
+        m_Position(0),
+        m_Size(0)
+    {
+    }
+    virtual ~Stream() = default;
+
+    Stream(const Stream&) = delete;
+    Stream& operator = (const Stream&) = delete;
+
+    virtual size_t Read(void* dest, size_t size) = 0;
+    virtual size_t Write(const void* data, size_t size) = 0;
+    /// Set position from the start, clamped to the size when reading. Return new position.
+    virtual size_t Seek(size_t position) = 0;
+    /// Return the whole contents if they are in memory, null otherwise.
+    virtual const unsigned char* Data() const { return nullptr; }
+
+    /// Read a trivially copyable value. Return a value-initialized one if the stream ends.
+    template <typename T> T ReadValue()
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Value must be trivially copyable");
+        T value{};
+        Read(&value, sizeof(T));
+        return value;
+    }
+    template <typename T> bool WriteValue(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Value must be trivially copyable");
+        return Write(&value, sizeof(T)) == sizeof(T);
+    }
+    /// Read count values. Return number of complete values read.
+    template <typename T> size_t ReadArray(T* dest, size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Value must be trivially copyable");
+        return Read(dest, count * sizeof(T)) / sizeof(T);
+    }
+    template <typename T> bool WriteArray(const T* data, size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Value must be trivially copyable");
+        return Write(data, count * sizeof(T)) == count * sizeof(T);
+    }
+    /// Read a string stored by WriteString(), a 32-bit length followed by the characters.
+    std::string ReadString();
+    bool WriteString(std::string_view str);
+    /// Read from the position to the end.
+    std::string ReadAll();
+
+    size_t Position() const { return m_Position; }
+    size_t Size() const { return m_Size; }
+    bool IsEof() const { return m_Position >= m_Size; }
+protected:
+    size_t m_Position;
+    size_t m_Size;
+};
+
+/// Stream over memory owned by the caller. Writes can not grow it.
+class MemoryStream : public Stream
+{
+public:
+    /// Construct read-only.
+    MemoryStream(const void* data, size_t size);
+    /// Construct readable and writable.
+    MemoryStream(void* data, size_t size);
+
+    virtual size_t Read(void* dest, size_t size) override;
+    virtual size_t Write(const void* data, size_t size) override;
+    virtual size_t Seek(size_t position) override;
+    virtual const unsigned char* Data() const override { return m_Data; }
+protected:
+    MemoryStream();
+
+    unsigned char* m_Data;
+    bool m_ReadOnly;
+};
+
+/// Read-only stream over a memory-mapped file. Pages are loaded by the OS when touched, nothing is copied.
+class MappedFileStream : public MemoryStream
+{
+public:
+    MappedFileStream();
+    MappedFileStream(std::string_view path);
+    virtual ~MappedFileStream() override;
+
+    /// Map a file, closing the previous one. Return false if it can not be opened.
+    bool Open(std::string_view path);
+    void Close();
+
+    bool IsOpen() const { return m_Data != nullptr; }
+private:
+#ifdef _WIN32
+    void* m_File;
+    void* m_Mapping;
+#endif
+};
+
+/// Buffered binary file. Small reads and writes go through the buffer, large ones and reads to the end go straight to the file.
+class FileStream : public Stream
+{
+public:
+    FileStream();
+    FileStream(std::string_view path, FileMode mode = FileMode::READ);
+    virtual ~FileStream() override;
+
+    /// Open a file, closing the previous one. Writing truncates the file. Return false if it can not be opened.
+    bool Open(std::string_view path, FileMode mode = FileMode::READ);
+    /// Flush and close.
+    void Close();
+    /// Write buffered data to the file.
+    void Flush();
+
+    virtual size_t Read(void* dest, size_t size) override;
+    virtual size_t Write(const void* data, size_t size) override;
+    virtual size_t Seek(size_t position) override;
+
+    bool IsOpen() const { return m_Handle != nullptr; }
+    FileMode Mode() const { return m_Mode; }
+private:
+    /// Move the file pointer if it is not at position.
+    bool SeekHandle(size_t position);
 
+    FILE* m_Handle;
+    FileMode m_Mode;
+    std::vector<unsigned char> m_Buffer;
+    /// File offset of the first buffered byte.
+    size_t m_BufferOffset;
+    /// Valid bytes in the buffer when reading, pending bytes when writing.
+    size_t m_BufferUsed;
+    /// Offset of the file pointer.
+    size_t m_HandlePosition;
 };
 
 } // namespace Pt
\ No newline at end of file
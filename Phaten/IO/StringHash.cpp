@@ -1,28 +1,82 @@
 #include "StringHash.hpp"
 
-#include <cctype>
+#include <mutex>
+#include <unordered_map>
 
 #include "StringUtils.hpp"
+#include "Logger.hpp"
 
 namespace Pt {
 
 const StringHash StringHash::ZERO;
 
+#ifdef PT_STRING_HASH_REGISTRY
+/// Registered strings by hash value.
+struct StringHashRegistry
+{
+    std::mutex mutex;
+    std::unordered_map<unsigned, std::string> strings;
+};
+
+/// Never destroyed, names may be registered or printed during static destruction.
+static StringHashRegistry& GetRegistry()
+{
+    static StringHashRegistry* registry = new StringHashRegistry();
+    return *registry;
+}
+
+/// Compare like the hash does, ASCII letters case-insensitive.
+static bool EqualsIgnoreCase(std::string_view lhs, std::string_view rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    for (size_t i = 0; i < lhs.size(); ++i)
+    {
+        char l = lhs[i] >= 'A' && lhs[i] <= 'Z' ? lhs[i] - 'A' + 'a' : lhs[i];
+        char r = rhs[i] >= 'A' && rhs[i] <= 'Z' ? rhs[i] - 'A' + 'a' : rhs[i];
+        if (l != r)
+            return false;
+    }
+    return true;
+}
+#endif
+
 std::string StringHash::ToString() const
 {
-    return FormatString("%08X", m_HashValue);
+    std::string name = Reverse(*this);
+    return name.empty() ? FormatString("%08X", m_HashValue) : FormatString("%08X (%s)", m_HashValue, name.c_str());
 }
 
-unsigned StringHash::Calculate(std::string_view str)
+StringHash StringHash::Register(std::string_view str)
 {
-    const char* ptr = str.data();
-    unsigned hash = 0;
-    while (*ptr)
+    StringHash hash(str);
+#ifdef PT_STRING_HASH_REGISTRY
+    if (!hash)
+        return hash;
+
+    StringHashRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto result = registry.strings.try_emplace(hash.m_HashValue, str);
+    if (!result.second && !EqualsIgnoreCase(result.first->second, str))
     {
-        hash = std::tolower(*ptr) + (hash << 6) + (hash << 16) - hash;
-        ++ptr;
+        PT_TAG_WARN("StringHash", "Collision between ", result.first->second, " and ", str, 
+            ", both hash to ", FormatString("%08X", hash.m_HashValue));
     }
+#endif
     return hash;
+}
 
+std::string StringHash::Reverse(StringHash hash)
+{
+#ifdef PT_STRING_HASH_REGISTRY
+    StringHashRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.strings.find(hash.m_HashValue);
+    if (it != registry.strings.end())
+        return it->second;
+#endif
+    return std::string();
 }
+
 } // namespace Pt
\ No newline at end of file
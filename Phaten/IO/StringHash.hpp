@@ -1,72 +1,145 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <string_view>
 
+#include "Core/Core.hpp"
+
 namespace Pt {
 
+/// Case-insensitive hash of a string. Constructed from a literal in a constant expression, it is computed at compile time.
 class StringHash
 {
 public:
-    StringHash() :
+    constexpr StringHash() :
         m_HashValue(0)
     {
     }
 
-    StringHash(const StringHash& hash) :
+    constexpr StringHash(const StringHash& hash) :
         m_HashValue(hash.m_HashValue)
     {
     }
 
-    explicit StringHash(unsigned hash) :
+    constexpr explicit StringHash(unsigned hash) :
         m_HashValue(hash)
     {
     }
 
-    StringHash(std::string_view hash) :
+    constexpr StringHash(std::string_view hash) :
         m_HashValue(Calculate(hash))
     {
     }
 
-    StringHash& operator = (const StringHash& rhs)
+    constexpr StringHash& operator = (const StringHash& rhs)
     {
         m_HashValue = rhs.m_HashValue;
         return *this;
     }
 
-    StringHash& operator = (std::string_view rhs)
+    constexpr StringHash& operator = (std::string_view rhs)
     {
         m_HashValue = Calculate(rhs);
         return *this;
     }
 
-    StringHash operator + (const StringHash& rhs)
+    constexpr StringHash operator + (const StringHash& rhs) const
     {
         StringHash ret;
         ret.m_HashValue = m_HashValue + rhs.m_HashValue;
         return ret;
     }
 
-    StringHash& operator += (const StringHash& rhs)
+    constexpr StringHash& operator += (const StringHash& rhs)
     {
         m_HashValue += rhs.m_HashValue;
         return *this;
     }
 
-    bool operator == (const StringHash& rhs) const { return m_HashValue == rhs.m_HashValue; }
-    bool operator != (const StringHash& rhs) const { return m_HashValue != rhs.m_HashValue; }
-    bool operator > (const StringHash& rhs) const { return m_HashValue > rhs.m_HashValue; }
-    bool operator < (const StringHash& rhs) const { return m_HashValue < rhs.m_HashValue; }
-    operator bool () const { return m_HashValue != 0; }
+    constexpr bool operator == (const StringHash& rhs) const { return m_HashValue == rhs.m_HashValue; }
+    constexpr bool operator != (const StringHash& rhs) const { return m_HashValue != rhs.m_HashValue; }
+    constexpr bool operator > (const StringHash& rhs) const { return m_HashValue > rhs.m_HashValue; }
+    constexpr bool operator < (const StringHash& rhs) const { return m_HashValue < rhs.m_HashValue; }
+    constexpr operator bool () const { return m_HashValue != 0; }
 
+    /// Return hex value, followed by the registered string if known.
     std::string ToString() const;
-    unsigned ToHash() const { return m_HashValue; }
+    constexpr unsigned ToHash() const { return m_HashValue; }
+
+    /// Hash the characters of str, which need not be null-terminated. ASCII letters are lowercased.
+    /// Consumes eight bytes per step, the empty string hashes to zero.
+    static constexpr unsigned Calculate(std::string_view str)
+    {
+        uint64_t hash = str.size() * HASH_MULTIPLIER;
+        size_t i = 0;
+        for (; i + 8 <= str.size(); i += 8)
+            hash = Mix(hash, LoadLowerWord(str, i, 8));
+        if (i < str.size())
+            hash = Mix(hash, LoadLowerWord(str, i, str.size() - i));
+
+        // Fold the high bits in, the low 32 bits are kept.
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        return static_cast<unsigned>(hash);
+    }
 
-    static unsigned Calculate(std::string_view str);
+    /// Hash str and remember it for ToString() and collision checks. Use for names that become lookup keys.
+    /// Only records when PT_STRING_HASH_REGISTRY is defined. Thread-safe.
+    static StringHash Register(std::string_view str);
+    /// Return the registered string of a hash, empty if unknown.
+    static std::string Reverse(StringHash hash);
 
     /// Zero hash value(00000000).
     static const StringHash ZERO; 
 private:
+    static constexpr uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ull;
+
+    /// Load up to eight bytes little-endian and lowercase the ASCII letters in all of them at once.
+    static constexpr uint64_t LoadLowerWord(std::string_view str, size_t offset, size_t count)
+    {
+        uint64_t word = 0;
+        for (size_t i = 0; i < count; ++i)
+            word |= static_cast<uint64_t>(static_cast<unsigned char>(str[offset + i])) << (i * 8);
+
+        constexpr uint64_t ONES = 0x0101010101010101ull;
+        constexpr uint64_t HIGH_BITS = ONES * 0x80;
+        uint64_t low = word & ~HIGH_BITS;
+        // High bit of each byte set if the byte is at least 'A', or greater than 'Z'.
+        uint64_t atLeastA = low + ONES * (0x80 - 'A');
+        uint64_t aboveZ = low + ONES * (0x80 - 'Z' - 1);
+        uint64_t upper = atLeastA & ~aboveZ & ~word & HIGH_BITS;
+        return word | (upper >> 2);
+    }
+
+    /// Multiply to 128 bits and fold the halves together, so every bit of the word reaches every bit of the hash.
+    static constexpr uint64_t Mix(uint64_t hash, uint64_t word)
+    {
+        uint64_t value = hash ^ word;
+#ifdef __SIZEOF_INT128__
+        __uint128_t product = static_cast<__uint128_t>(value) * HASH_MULTIPLIER;
+        return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+        constexpr uint64_t LOW_MASK = 0xFFFFFFFFull;
+        uint64_t lowLow = (value & LOW_MASK) * (HASH_MULTIPLIER & LOW_MASK);
+        uint64_t lowHigh = (value & LOW_MASK) * (HASH_MULTIPLIER >> 32);
+        uint64_t highLow = (value >> 32) * (HASH_MULTIPLIER & LOW_MASK);
+        uint64_t highHigh = (value >> 32) * (HASH_MULTIPLIER >> 32);
+        uint64_t middle = (lowLow >> 32) + (lowHigh & LOW_MASK) + (highLow & LOW_MASK);
+        uint64_t low = (lowLow & LOW_MASK) | (middle << 32);
+        uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+        return low ^ high;
+#endif
+    }
+
     unsigned m_HashValue;
 };
 
+/// Hash a string literal at compile time, e.g. "u_Model"_hash.
+constexpr StringHash operator ""_hash(const char* str, size_t length)
+{
+    return StringHash(std::string_view(str, length));
+}
+
 } // namespace Pt
\ No newline at end of file
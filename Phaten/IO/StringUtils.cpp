@@ -3,10 +3,11 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
-#include <fstream>
 #include <cstdarg>
 
 #include "IO/Assert.hpp"
+#include "IO/Stream.hpp"
+#include "Object/LinearAllocator.hpp"
 
 namespace Pt {
 
@@ -15,20 +16,15 @@ namespace Pt {
 
 std::string ReadFile(std::string_view path)
 {
-    std::ifstream file(path.data());
-    if (!file.is_open())
+    FileStream file(path);
+    if (!file.IsOpen())
     {
         PT_ASSERT_MSG(false, "Failed to open file: ", path);
         return "";
     }
 
-    std::string content;
-    std::string line;
-    while (std::getline(file, line))
-    {
-        content += line + "\n";
-    }
-    return content;
+    // Sized once and filled by a single read.
+    return file.ReadAll();
 }
 
 std::string FormatString(const char* format, ...)
@@ -41,6 +37,27 @@ std::string FormatString(const char* format, ...)
     return std::string(buffer);
 }
 
+std::string_view FormatString(LinearAllocator& allocator, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    va_list measureArgs;
+    va_copy(measureArgs, args);
+    int length = vsnprintf(nullptr, 0, format, measureArgs);
+    va_end(measureArgs);
+
+    if (length < 0)
+    {
+        va_end(args);
+        return std::string_view();
+    }
+
+    char* buffer = allocator.Allocate<char>(length + 1);
+    vsnprintf(buffer, length + 1, format, args);
+    va_end(args);
+    return std::string_view(buffer, length);
+}
+
 std::vector<std::string> Split(std::string_view str, char delimiter)
 {
     std::vector<std::string> ret;
@@ -8,12 +8,17 @@
 
 namespace Pt {
 
+class LinearAllocator;
+
 /// Process ===================================================================
 /// ===========================================================================
 
+/// Read a whole file as is, line endings are not changed.
 std::string ReadFile(std::string_view path);
 
 std::string FormatString(const char* format, ...);
+/// Format into memory from the allocator. The result is valid until the allocator is reset.
+std::string_view FormatString(LinearAllocator& allocator, const char* format, ...);
 
 template <typename... Args>
 std::string StringConcatenate(char connector, const std::string& first, Args... args)
@@ -4,13 +4,17 @@
 
 #include "Graphics/GraphicsDefs.hpp"
 #include "Graphics/Texture.hpp"
+#include "IO/Logger.hpp"
 #include "IO/StringUtils.hpp"
 
 #include "Graphics/UniformBuffer.hpp"
 
+#include "Object/Allocator.hpp"
 #include "Object/Ptr.hpp"
+#include "Renderer/RenderQueue.hpp"
 #include "Renderer/StaticGeometry.hpp"
 #include "Renderer/TextRenderer.hpp"
+#include "Resource/ResourceLoader.hpp"
 
 namespace Pt {
 
@@ -19,6 +23,10 @@ Vector2 Application::sWindowSize {1280, 720};
 Application::Application() :
     m_RenderState(false)
 {
+    // Workers and the render loop should not wait for the console.
+    LoggerManager::Instance().GetDefaultLogger().SetAsync(true);
+
+    m_JobSystem = CreateScoped<JobSystem>();
     m_Window = CreateShared<Window>(WindowCreateInfo{"Phaten", sWindowSize, ScreenMode::WINDOWED});
 
     m_Input = CreateScoped<Input>();
@@ -29,6 +37,10 @@ Application::Application() :
 
 Application::~Application()
 {
+    // Join the workers first so that no thread is logging while the writer stops.
+    m_JobSystem.Reset();
+    // Members are destroyed after this, so their logs are written synchronously.
+    LoggerManager::Instance().GetDefaultLogger().SetAsync(false);
 }
 
 void Application::Run()
@@ -40,6 +52,7 @@ void Application::OnRender()
 {
     auto graphics = CreateScoped<Graphics>(m_Window);
     if (!graphics->IsInitialized()) return;
+    auto resourceLoader = CreateScoped<ResourceLoader>();
 
     m_Frequency = (double)SDL_GetPerformanceFrequency();
 
@@ -66,14 +79,16 @@ void Application::OnRender()
     auto demoCube = Cube();
     auto screen = ScreenPlane();
     auto textRenderer = CreateScoped<TextRenderer>(textProgram, 3.0f);
+    RenderQueue renderQueue;
+    RenderCommandList commandList;
 
     // for demo
-    SharedPtr<Image> demoImage = Object::FactoryCreate<Image>();
-    demoImage->Load("Assets/Textures/player.png");
-
     SharedPtr<Texture> demoTexture = Object::FactoryCreate<Texture>();
-    demoTexture->Define(TextureType::TEX_2D, demoImage);
-    demoTexture->SetFilterMode(TextureFilterMode::NEAREST);
+    demoTexture->SetName("Assets/Textures/player.png");
+    resourceLoader->LoadAsync(demoTexture, [](Resource* resource, bool success) {
+        if (success)
+            static_cast<Texture*>(resource)->SetFilterMode(TextureFilterMode::NEAREST);
+    });
 
     m_Camera = CreateShared<Camera>();
     m_Camera->SetPerspective(60.0f, 0.1f, 100.0f);
@@ -91,7 +106,8 @@ void Application::OnRender()
     SDL_GL_MakeCurrent(SDL_GL_GetCurrentWindow(), SDL_GL_GetCurrentContext());
     bool enablePostEffect = false;
     bool showDebug = false;
-    std::string debugString = "Phaten Engine\nFPS:%.2f\nVSync:%s\nCamera Rotation:%s\nCamera Position:%s";
+    // Vectors are formatted in place, ToString() would allocate every frame.
+    const char* debugString = "Phaten Engine\nFPS:%.2f\nVSync:%s\nCamera Rotation:%f, %f, %f, %f\nCamera Position:%f %f %f\nGL State Changes:%u (%u filtered)\nVertex Arrays:%zu";
     while (m_RenderState & !m_Input->ShouldExit())
     {
         // Poll input events.
@@ -129,6 +145,9 @@ void Application::OnRender()
             }
         }
 
+        // Finish background loads on the graphics thread.
+        resourceLoader->Update();
+
         uint64_t currentTime = SDL_GetPerformanceCounter();
         m_DeltaTime = (currentTime - m_LastTime) / m_Frequency;
         m_LastTime = currentTime;
@@ -140,20 +159,27 @@ void Application::OnRender()
         Graphics::SetFrameBuffer(fbo);
         Graphics::Clear(BufferBitType::COLOR | BufferBitType::DEPTH);
 
-        demoTexture->Bind(1);
         Graphics::SetDepthTest(true);
-        demoCube.Draw(basicProgram);
+        RenderCommand cubeCommand = demoCube.Command(basicProgram);
+        cubeCommand.textures[1] = demoTexture.Get();
+        commandList.Add(cubeCommand);
+        renderQueue.Submit(commandList);
+        renderQueue.Execute();
         /// ====================================================================
         if (showDebug)
         {
             Graphics::Clear(BufferBitType::DEPTH);
             Graphics::SetDepthTest(true);
+            const Quaternion& rotation = m_Camera->GetRotation();
+            const Vector3& position = m_Camera->GetPosition();
             textRenderer->Render({8}, 
-                FormatString(debugString.c_str(), 
+                FormatString(graphics->GetFrameAllocator(), debugString, 
                     m_FPS, 
                     graphics->IsVSync() ? "On" : "Off",
-                    m_Camera->GetRotation().ToString().c_str(),
-                    m_Camera->GetPosition().ToString().c_str()
+                    rotation.w, rotation.x, rotation.y, rotation.z,
+                    position.x, position.y, position.z,
+                    Graphics::FrameStats().issued, Graphics::FrameStats().filtered,
+                    Graphics::NumVertexArrays()
                 )
             );
         }
@@ -171,6 +197,8 @@ void Application::OnRender()
         // Call window to swap buffers.
         graphics->Present();
     }
+
+    LogAllocatorStats();
 }
 
 } // namespace Pt
\ No newline at end of file
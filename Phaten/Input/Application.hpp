@@ -4,6 +4,7 @@
 #include "Input/Window.hpp"
 #include "Input/Input.hpp"
 #include "Scene/SceneCameraController.hpp"
+#include "Thread/JobSystem.hpp"
 
 namespace Pt {
 
@@ -19,6 +20,8 @@ public:
 
     static Vector2 sWindowSize;
 private:
+    /// Created first so every other system can queue jobs. ~Application joins it before async logging stops.
+    ScopedPtr<JobSystem> m_JobSystem;
     SharedPtr<Window> m_Window;
     ScopedPtr<Input> m_Input;
 
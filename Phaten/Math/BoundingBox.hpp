@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+
+#include "Math.hpp"
+#include "Vector.hpp"
+
+namespace Pt {
+
+/// Axis-aligned bounding box.
+class BoundingBox
+{
+public:
+    Vector3 min;
+    Vector3 max;
+
+    /// Construct as undefined, merging any point defines it.
+    BoundingBox() :
+        min(M_MAX_FLOAT),
+        max(-M_MAX_FLOAT)
+    {
+    }
+
+    BoundingBox(const BoundingBox& box) :
+        min(box.min),
+        max(box.max)
+    {
+    }
+
+    BoundingBox(const Vector3& min_, const Vector3& max_) :
+        min(min_),
+        max(max_)
+    {
+    }
+
+    BoundingBox& operator = (const BoundingBox& rhs)
+    {
+        min = rhs.min;
+        max = rhs.max;
+        return *this;
+    }
+
+    bool operator == (const BoundingBox& rhs) const { return min == rhs.min && max == rhs.max; }
+    bool operator != (const BoundingBox& rhs) const { return min != rhs.min || max != rhs.max; }
+
+    /// Merge a point.
+    void Merge(const Vector3& point)
+    {
+        min = Vector3(std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z));
+        max = Vector3(std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z));
+    }
+
+    /// Merge another box.
+    void Merge(const BoundingBox& box)
+    {
+        min = Vector3(std::min(min.x, box.min.x), std::min(min.y, box.min.y), std::min(min.z, box.min.z));
+        max = Vector3(std::max(max.x, box.max.x), std::max(max.y, box.max.y), std::max(max.z, box.max.z));
+    }
+
+    /// Reset to undefined.
+    void Clear()
+    {
+        min = Vector3(M_MAX_FLOAT);
+        max = Vector3(-M_MAX_FLOAT);
+    }
+
+    bool IsDefined() const { return min.x <= max.x; }
+    Vector3 Center() const { return (min + max) * 0.5f; }
+    Vector3 Size() const { return max - min; }
+
+    /// Return surface area, 0 if undefined.
+    float SurfaceArea() const
+    {
+        if (!IsDefined())
+            return 0.0f;
+        Vector3 size = max - min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    /// Return index of the longest axis.
+    unsigned LongestAxis() const
+    {
+        Vector3 size = max - min;
+        if (size.x >= size.y && size.x >= size.z)
+            return 0;
+        return size.y >= size.z ? 1 : 2;
+    }
+};
+
+} // namespace Pt
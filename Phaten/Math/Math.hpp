@@ -12,6 +12,7 @@ static const float M_2_PI = 6.28318530717958647692f;
 static const float M_DEG_TO_RAD = M_PI / 180.0f;
 static const float M_RAD_TO_DEG = 180.0f / M_PI;
 static const float M_EPSILON = 0.000000001f;
+static const float M_MAX_FLOAT = std::numeric_limits<float>::max();
 
 static bool EpsilonEqual(float lhs, float rhs, float epsilon = M_EPSILON) { return lhs + epsilon >= rhs && lhs - epsilon <= rhs; }
 static bool EpsilonNotEqual(float lhs, float rhs, float epsilon = M_EPSILON) { return lhs + epsilon < rhs || lhs - epsilon > rhs; }
@@ -25,20 +25,7 @@ public:
     }
 
     // Copy constructor
-    Matrix3(const Matrix3& matrix)
-    {
-        this->data[0][0] = matrix.data[0][0];
-        this->data[1][0] = matrix.data[1][0];
-        this->data[2][0] = matrix.data[2][0];
-
-        this->data[0][1] = matrix.data[0][1];
-        this->data[1][1] = matrix.data[1][1];
-        this->data[2][1] = matrix.data[2][1];
-
-        this->data[0][2] = matrix.data[0][2];
-        this->data[1][2] = matrix.data[1][2];
-        this->data[2][2] = matrix.data[2][2];
-    }
+    Matrix3(const Matrix3& matrix) = default;
 
     // Construct from 3 vectors
     Matrix3(const Vector3& v1, const Vector3& v2, const Vector3& v3)
@@ -105,22 +92,7 @@ public:
         this->data[2][2] = m22;
     }
 
-    Matrix3& operator = (const Matrix3& rhs)
-    {
-        this->data[0][0] = rhs.data[0][0];
-        this->data[1][0] = rhs.data[1][0];
-        this->data[2][0] = rhs.data[2][0];
-
-        this->data[0][1] = rhs.data[0][1];
-        this->data[1][1] = rhs.data[1][1];
-        this->data[2][1] = rhs.data[2][1];
-
-        this->data[0][2] = rhs.data[0][2];
-        this->data[1][2] = rhs.data[1][2];
-        this->data[2][2] = rhs.data[2][2];
-
-        return *this;
-    }
+    Matrix3& operator = (const Matrix3& rhs) = default;
 
     bool operator == (const Matrix3& rhs) const 
     {
@@ -300,35 +272,15 @@ std::ostream& operator << (std::ostream& os, const Matrix3& matrix);
 class Matrix4
 {
 public:
-    float data[4][4];
+    /// Columns are 16 byte aligned for SIMD loads.
+    alignas(16) float data[4][4];
 
     Matrix4()
     {
     }
 
     // Copy constructor
-    Matrix4(const Matrix4& matrix)
-    {
-        this->data[0][0] = matrix.data[0][0];
-        this->data[1][0] = matrix.data[1][0];
-        this->data[2][0] = matrix.data[2][0];
-        this->data[3][0] = matrix.data[3][0];
-
-        this->data[0][1] = matrix.data[0][1];
-        this->data[1][1] = matrix.data[1][1];
-        this->data[2][1] = matrix.data[2][1];
-        this->data[3][1] = matrix.data[3][1];
-
-        this->data[0][2] = matrix.data[0][2];
-        this->data[1][2] = matrix.data[1][2];
-        this->data[2][2] = matrix.data[2][2];
-        this->data[3][2] = matrix.data[3][2];
-
-        this->data[0][3] = matrix.data[0][3];
-        this->data[1][3] = matrix.data[1][3];
-        this->data[2][3] = matrix.data[2][3];
-        this->data[3][3] = matrix.data[3][3];
-    }
+    Matrix4(const Matrix4& matrix) = default;
 
     // Construct from 4 vectors
     Matrix4(const Vector4& v1, const Vector4& v2, const Vector4& v3, const Vector4& v4)
@@ -442,30 +394,7 @@ public:
         this->data[3][3] = 1.0f;
     }
 
-    Matrix4& operator = (const Matrix4& rhs)
-    {
-        this->data[0][0] = rhs.data[0][0];
-        this->data[1][0] = rhs.data[1][0];
-        this->data[2][0] = rhs.data[2][0];
-        this->data[3][0] = rhs.data[3][0];
-
-        this->data[0][1] = rhs.data[0][1];
-        this->data[1][1] = rhs.data[1][1];
-        this->data[2][1] = rhs.data[2][1];
-        this->data[3][1] = rhs.data[3][1];
-
-        this->data[0][2] = rhs.data[0][2];
-        this->data[1][2] = rhs.data[1][2];
-        this->data[2][2] = rhs.data[2][2];
-        this->data[3][2] = rhs.data[3][2];
-
-        this->data[0][3] = rhs.data[0][3];
-        this->data[1][3] = rhs.data[1][3];
-        this->data[2][3] = rhs.data[2][3];
-        this->data[3][3] = rhs.data[3][3];
-
-        return *this;
-    }
+    Matrix4& operator = (const Matrix4& rhs) = default;
 
     bool operator == (const Matrix4& rhs) const 
     {
@@ -682,7 +611,33 @@ public:
 
         float OneOverDeterminant = 1.0f / Dot1;
 
-        return Inverse * OneOverDeterminant;
+        // Inverse was built from rows, the adjugate columns must be columns.
+        return Inverse.Transposed() * OneOverDeterminant;
+    }
+
+    /// Return inverse of an affine transform whose last row is (0, 0, 0, 1). Cheaper than Inverse().
+    Matrix4 AffineInverse() const
+    {
+        Vector3 c0(data[0][0], data[0][1], data[0][2]);
+        Vector3 c1(data[1][0], data[1][1], data[1][2]);
+        Vector3 c2(data[2][0], data[2][1], data[2][2]);
+        Vector3 translation(data[3][0], data[3][1], data[3][2]);
+
+        // Rows of the inverse 3x3 part are the cross products of its columns.
+        float oneOverDeterminant = 1.0f / c0.Dot(c1.Cross(c2));
+        Vector3 r0 = c1.Cross(c2) * oneOverDeterminant;
+        Vector3 r1 = c2.Cross(c0) * oneOverDeterminant;
+        Vector3 r2 = c0.Cross(c1) * oneOverDeterminant;
+
+        Matrix4 result;
+        result.data[0][0] = r0.x; result.data[0][1] = r1.x; result.data[0][2] = r2.x; result.data[0][3] = 0.0f;
+        result.data[1][0] = r0.y; result.data[1][1] = r1.y; result.data[1][2] = r2.y; result.data[1][3] = 0.0f;
+        result.data[2][0] = r0.z; result.data[2][1] = r1.z; result.data[2][2] = r2.z; result.data[2][3] = 0.0f;
+        result.data[3][0] = -r0.Dot(translation);
+        result.data[3][1] = -r1.Dot(translation);
+        result.data[3][2] = -r2.Dot(translation);
+        result.data[3][3] = 1.0f;
+        return result;
     }
 
     static const Matrix4 ZERO;
@@ -704,24 +659,7 @@ public:
     }
 
     /// Copy constructor.
-    Matrix3x4(const Matrix3x4& matrix)
-    {
-        this->data[0][0] = matrix.data[0][0];
-        this->data[1][0] = matrix.data[1][0];
-        this->data[2][0] = matrix.data[2][0];
-
-        this->data[0][1] = matrix.data[0][1];
-        this->data[1][1] = matrix.data[1][1];
-        this->data[2][1] = matrix.data[2][1];
-
-        this->data[0][2] = matrix.data[0][2];
-        this->data[1][2] = matrix.data[1][2];
-        this->data[2][2] = matrix.data[2][2];
-
-        this->data[0][3] = matrix.data[0][3];
-        this->data[1][3] = matrix.data[1][3];
-        this->data[2][3] = matrix.data[2][3];
-    }
+    Matrix3x4(const Matrix3x4& matrix) = default;
 
     /// Construct from a matrix3.
     Matrix3x4(const Matrix3& matrix)
@@ -830,26 +768,7 @@ public:
         this->data[2][3] = m23;
     }
 
-    Matrix3x4& operator = (const Matrix3x4& rhs)
-    {
-        this->data[0][0] = rhs.data[0][0];
-        this->data[1][0] = rhs.data[1][0];
-        this->data[2][0] = rhs.data[2][0];
-
-        this->data[0][1] = rhs.data[0][1];
-        this->data[1][1] = rhs.data[1][1];
-        this->data[2][1] = rhs.data[2][1];
-
-        this->data[0][2] = rhs.data[0][2];
-        this->data[1][2] = rhs.data[1][2];
-        this->data[2][2] = rhs.data[2][2];
-
-        this->data[0][3] = rhs.data[0][3];
-        this->data[1][3] = rhs.data[1][3];
-        this->data[2][3] = rhs.data[2][3];
-
-        return *this;
-    }
+    Matrix3x4& operator = (const Matrix3x4& rhs) = default;
 
     Matrix3x4& operator = (const Matrix3& rhs)
     {
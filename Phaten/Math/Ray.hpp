@@ -0,0 +1,100 @@
+#pragma once
+
+#include "BoundingBox.hpp"
+#include "Math.hpp"
+#include "Vector.hpp"
+
+namespace Pt {
+
+/// Infinite straight line in three-dimensional space.
+class Ray
+{
+public:
+    Vector3 origin;
+    Vector3 direction;
+
+    Ray()
+    {
+    }
+
+    Ray(const Ray& ray) :
+        origin(ray.origin),
+        direction(ray.direction)
+    {
+    }
+
+    /// Construct from origin and direction. The direction is normalized.
+    Ray(const Vector3& origin_, const Vector3& direction_) :
+        origin(origin_),
+        direction(Normalize(direction_))
+    {
+    }
+
+    Ray& operator = (const Ray& rhs)
+    {
+        origin = rhs.origin;
+        direction = rhs.direction;
+        return *this;
+    }
+
+    /// Return the point at distance along the ray.
+    Vector3 At(float distance) const { return origin + direction * distance; }
+
+    /// Return hit distance to a bounding box, 0 if inside, or M_MAX_FLOAT if no hit.
+    float HitDistance(const BoundingBox& box) const
+    {
+        float near = 0.0f;
+        float far = M_MAX_FLOAT;
+        for (int i = 0; i < 3; ++i)
+        {
+            if (::Abs(direction[i]) < M_EPSILON)
+            {
+                if (origin[i] < box.min[i] || origin[i] > box.max[i])
+                    return M_MAX_FLOAT;
+                continue;
+            }
+
+            float invDirection = 1.0f / direction[i];
+            float t0 = (box.min[i] - origin[i]) * invDirection;
+            float t1 = (box.max[i] - origin[i]) * invDirection;
+            near = std::max(near, std::min(t0, t1));
+            far = std::min(far, std::max(t0, t1));
+            if (near > far)
+                return M_MAX_FLOAT;
+        }
+        return near;
+    }
+
+    /// Return hit distance to a triangle, or M_MAX_FLOAT if no hit. Both faces are hit.
+    float HitDistance(const Vector3& v0, const Vector3& v1, const Vector3& v2, Vector3* outNormal = nullptr) const
+    {
+        // Moller-Trumbore
+        Vector3 edge1 = v1 - v0;
+        Vector3 edge2 = v2 - v0;
+        Vector3 p = direction.Cross(edge2);
+        float det = edge1.Dot(p);
+        if (::Abs(det) < M_EPSILON)
+            return M_MAX_FLOAT;
+
+        float invDet = 1.0f / det;
+        Vector3 t = origin - v0;
+        float u = t.Dot(p) * invDet;
+        if (u < 0.0f || u > 1.0f)
+            return M_MAX_FLOAT;
+
+        Vector3 q = t.Cross(edge1);
+        float v = direction.Dot(q) * invDet;
+        if (v < 0.0f || u + v > 1.0f)
+            return M_MAX_FLOAT;
+
+        float distance = edge2.Dot(q) * invDet;
+        if (distance < 0.0f)
+            return M_MAX_FLOAT;
+
+        if (outNormal)
+            *outNormal = Normalize(edge1.Cross(edge2));
+        return distance;
+    }
+};
+
+} // namespace Pt
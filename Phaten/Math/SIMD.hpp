@@ -0,0 +1,367 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "Core/Core.hpp"
+
+#if defined(PT_SIMD_AVX2)
+    #include <immintrin.h>
+#elif defined(PT_SIMD_SSE)
+    #include <emmintrin.h>
+#elif defined(PT_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+namespace Pt {
+
+/// 4 float lanes. Comparisons return lane masks with all bits set or cleared.
+class Float4
+{
+public:
+    static constexpr unsigned SIZE = 4;
+
+#if defined(PT_SIMD_SSE)
+    __m128 v;
+
+    Float4()
+    {
+    }
+
+    Float4(__m128 value) :
+        v(value)
+    {
+    }
+
+    /// Broadcast to all lanes.
+    Float4(float value) :
+        v(_mm_set1_ps(value))
+    {
+    }
+
+    Float4(float x, float y, float z, float w) :
+        v(_mm_setr_ps(x, y, z, w))
+    {
+    }
+
+    static Float4 Load(const float* data) { return _mm_loadu_ps(data); }
+    static Float4 LoadAligned(const float* data) { return _mm_load_ps(data); }
+    void Store(float* data) const { _mm_storeu_ps(data, v); }
+    void StoreAligned(float* data) const { _mm_store_ps(data, v); }
+
+    Float4 operator + (const Float4& rhs) const { return _mm_add_ps(v, rhs.v); }
+    Float4 operator - (const Float4& rhs) const { return _mm_sub_ps(v, rhs.v); }
+    Float4 operator * (const Float4& rhs) const { return _mm_mul_ps(v, rhs.v); }
+    Float4 operator / (const Float4& rhs) const { return _mm_div_ps(v, rhs.v); }
+    Float4 operator - () const { return _mm_sub_ps(_mm_setzero_ps(), v); }
+
+    Float4 operator < (const Float4& rhs) const { return _mm_cmplt_ps(v, rhs.v); }
+    Float4 operator <= (const Float4& rhs) const { return _mm_cmple_ps(v, rhs.v); }
+    Float4 operator > (const Float4& rhs) const { return _mm_cmpgt_ps(v, rhs.v); }
+    Float4 operator >= (const Float4& rhs) const { return _mm_cmpge_ps(v, rhs.v); }
+    Float4 operator & (const Float4& rhs) const { return _mm_and_ps(v, rhs.v); }
+    Float4 operator | (const Float4& rhs) const { return _mm_or_ps(v, rhs.v); }
+
+    /// Return bit per lane with the lane mask.
+    int Mask() const { return _mm_movemask_ps(v); }
+
+    static Float4 Min(const Float4& lhs, const Float4& rhs) { return _mm_min_ps(lhs.v, rhs.v); }
+    static Float4 Max(const Float4& lhs, const Float4& rhs) { return _mm_max_ps(lhs.v, rhs.v); }
+    /// Return lanes of lhs where mask is set, otherwise rhs.
+    static Float4 Select(const Float4& mask, const Float4& lhs, const Float4& rhs) { return _mm_or_ps(_mm_and_ps(mask.v, lhs.v), _mm_andnot_ps(mask.v, rhs.v)); }
+    static Float4 Abs(const Float4& value) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value.v); }
+    static Float4 Sqrt(const Float4& value) { return _mm_sqrt_ps(value.v); }
+    /// Transpose 4 rows into 4 columns in place.
+    static void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) { _MM_TRANSPOSE4_PS(r0.v, r1.v, r2.v, r3.v); }
+#elif defined(PT_SIMD_NEON)
+    float32x4_t v;
+
+    Float4()
+    {
+    }
+
+    Float4(float32x4_t value) :
+        v(value)
+    {
+    }
+
+    /// Broadcast to all lanes.
+    Float4(float value) :
+        v(vdupq_n_f32(value))
+    {
+    }
+
+    Float4(float x, float y, float z, float w)
+    {
+        const float data[SIZE] = { x, y, z, w };
+        v = vld1q_f32(data);
+    }
+
+    static Float4 Load(const float* data) { return vld1q_f32(data); }
+    static Float4 LoadAligned(const float* data) { return vld1q_f32(data); }
+    void Store(float* data) const { vst1q_f32(data, v); }
+    void StoreAligned(float* data) const { vst1q_f32(data, v); }
+
+    Float4 operator + (const Float4& rhs) const { return vaddq_f32(v, rhs.v); }
+    Float4 operator - (const Float4& rhs) const { return vsubq_f32(v, rhs.v); }
+    Float4 operator * (const Float4& rhs) const { return vmulq_f32(v, rhs.v); }
+    Float4 operator / (const Float4& rhs) const { return vdivq_f32(v, rhs.v); }
+    Float4 operator - () const { return vnegq_f32(v); }
+
+    Float4 operator < (const Float4& rhs) const { return vreinterpretq_f32_u32(vcltq_f32(v, rhs.v)); }
+    Float4 operator <= (const Float4& rhs) const { return vreinterpretq_f32_u32(vcleq_f32(v, rhs.v)); }
+    Float4 operator > (const Float4& rhs) const { return vreinterpretq_f32_u32(vcgtq_f32(v, rhs.v)); }
+    Float4 operator >= (const Float4& rhs) const { return vreinterpretq_f32_u32(vcgeq_f32(v, rhs.v)); }
+    Float4 operator & (const Float4& rhs) const { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(v), vreinterpretq_u32_f32(rhs.v))); }
+    Float4 operator | (const Float4& rhs) const { return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(v), vreinterpretq_u32_f32(rhs.v))); }
+
+    /// Return bit per lane with the lane mask.
+    int Mask() const
+    {
+        static const int32_t shifts[SIZE] = { 0, 1, 2, 3 };
+        uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(v), 31);
+        return static_cast<int>(vaddvq_u32(vshlq_u32(bits, vld1q_s32(shifts))));
+    }
+
+    static Float4 Min(const Float4& lhs, const Float4& rhs) { return vminq_f32(lhs.v, rhs.v); }
+    static Float4 Max(const Float4& lhs, const Float4& rhs) { return vmaxq_f32(lhs.v, rhs.v); }
+    /// Return lanes of lhs where mask is set, otherwise rhs.
+    static Float4 Select(const Float4& mask, const Float4& lhs, const Float4& rhs) { return vbslq_f32(vreinterpretq_u32_f32(mask.v), lhs.v, rhs.v); }
+    static Float4 Abs(const Float4& value) { return vabsq_f32(value.v); }
+    static Float4 Sqrt(const Float4& value) { return vsqrtq_f32(value.v); }
+    /// Transpose 4 rows into 4 columns in place.
+    static void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3)
+    {
+        float32x4x2_t t01 = vtrnq_f32(r0.v, r1.v);
+        float32x4x2_t t23 = vtrnq_f32(r2.v, r3.v);
+        r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+        r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+        r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+        r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+    }
+#else
+    float v[4];
+
+    Float4()
+    {
+    }
+
+    /// Broadcast to all lanes.
+    Float4(float value) :
+        v{ value, value, value, value }
+    {
+    }
+
+    Float4(float x, float y, float z, float w) :
+        v{ x, y, z, w }
+    {
+    }
+
+    static Float4 Load(const float* data) { return Float4(data[0], data[1], data[2], data[3]); }
+    static Float4 LoadAligned(const float* data) { return Load(data); }
+    void Store(float* data) const { memcpy(data, v, sizeof(v)); }
+    void StoreAligned(float* data) const { Store(data); }
+
+    Float4 operator + (const Float4& rhs) const { return Float4(v[0] + rhs.v[0], v[1] + rhs.v[1], v[2] + rhs.v[2], v[3] + rhs.v[3]); }
+    Float4 operator - (const Float4& rhs) const { return Float4(v[0] - rhs.v[0], v[1] - rhs.v[1], v[2] - rhs.v[2], v[3] - rhs.v[3]); }
+    Float4 operator * (const Float4& rhs) const { return Float4(v[0] * rhs.v[0], v[1] * rhs.v[1], v[2] * rhs.v[2], v[3] * rhs.v[3]); }
+    Float4 operator / (const Float4& rhs) const { return Float4(v[0] / rhs.v[0], v[1] / rhs.v[1], v[2] / rhs.v[2], v[3] / rhs.v[3]); }
+    Float4 operator - () const { return Float4(-v[0], -v[1], -v[2], -v[3]); }
+
+    Float4 operator < (const Float4& rhs) const { return Compare(rhs, [](float a, float b) { return a < b; }); }
+    Float4 operator <= (const Float4& rhs) const { return Compare(rhs, [](float a, float b) { return a <= b; }); }
+    Float4 operator > (const Float4& rhs) const { return Compare(rhs, [](float a, float b) { return a > b; }); }
+    Float4 operator >= (const Float4& rhs) const { return Compare(rhs, [](float a, float b) { return a >= b; }); }
+    Float4 operator & (const Float4& rhs) const { return Bitwise(rhs, [](uint32_t a, uint32_t b) { return a & b; }); }
+    Float4 operator | (const Float4& rhs) const { return Bitwise(rhs, [](uint32_t a, uint32_t b) { return a | b; }); }
+
+    /// Return bit per lane with the lane mask.
+    int Mask() const
+    {
+        int mask = 0;
+        for (unsigned i = 0; i < SIZE; ++i)
+            mask |= (Bits(v[i]) >> 31) << i;
+        return mask;
+    }
+
+    static Float4 Min(const Float4& lhs, const Float4& rhs) { return Float4(lhs.v[0] < rhs.v[0] ? lhs.v[0] : rhs.v[0], lhs.v[1] < rhs.v[1] ? lhs.v[1] : rhs.v[1], lhs.v[2] < rhs.v[2] ? lhs.v[2] : rhs.v[2], lhs.v[3] < rhs.v[3] ? lhs.v[3] : rhs.v[3]); }
+    static Float4 Max(const Float4& lhs, const Float4& rhs) { return Float4(lhs.v[0] > rhs.v[0] ? lhs.v[0] : rhs.v[0], lhs.v[1] > rhs.v[1] ? lhs.v[1] : rhs.v[1], lhs.v[2] > rhs.v[2] ? lhs.v[2] : rhs.v[2], lhs.v[3] > rhs.v[3] ? lhs.v[3] : rhs.v[3]); }
+    /// Return lanes of lhs where mask is set, otherwise rhs.
+    static Float4 Select(const Float4& mask, const Float4& lhs, const Float4& rhs)
+    {
+        Float4 result;
+        for (unsigned i = 0; i < SIZE; ++i)
+            result.v[i] = Bits(mask.v[i]) ? lhs.v[i] : rhs.v[i];
+        return result;
+    }
+    static Float4 Abs(const Float4& value) { return Float4(value.v[0] < 0.0f ? -value.v[0] : value.v[0], value.v[1] < 0.0f ? -value.v[1] : value.v[1], value.v[2] < 0.0f ? -value.v[2] : value.v[2], value.v[3] < 0.0f ? -value.v[3] : value.v[3]); }
+    static Float4 Sqrt(const Float4& value) { return Float4(sqrtf(value.v[0]), sqrtf(value.v[1]), sqrtf(value.v[2]), sqrtf(value.v[3])); }
+    /// Transpose 4 rows into 4 columns in place.
+    static void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3)
+    {
+        Float4* rows[SIZE] = { &r0, &r1, &r2, &r3 };
+        for (unsigned i = 0; i < SIZE; ++i)
+        {
+            for (unsigned j = i + 1; j < SIZE; ++j)
+            {
+                float value = rows[i]->v[j];
+                rows[i]->v[j] = rows[j]->v[i];
+                rows[j]->v[i] = value;
+            }
+        }
+    }
+private:
+    static uint32_t Bits(float value) { uint32_t bits; memcpy(&bits, &value, sizeof(bits)); return bits; }
+    static float FromBits(uint32_t bits) { float value; memcpy(&value, &bits, sizeof(value)); return value; }
+
+    template <typename F> Float4 Compare(const Float4& rhs, F function) const
+    {
+        Float4 result;
+        for (unsigned i = 0; i < SIZE; ++i)
+            result.v[i] = FromBits(function(v[i], rhs.v[i]) ? 0xFFFFFFFFu : 0u);
+        return result;
+    }
+
+    template <typename F> Float4 Bitwise(const Float4& rhs, F function) const
+    {
+        Float4 result;
+        for (unsigned i = 0; i < SIZE; ++i)
+            result.v[i] = FromBits(function(Bits(v[i]), Bits(rhs.v[i])));
+        return result;
+    }
+#endif
+
+public:
+    /// Return value of one lane.
+    float Lane(unsigned index) const
+    {
+        float data[SIZE];
+        Store(data);
+        return data[index];
+    }
+    /// Return true if any lane mask is set.
+    bool Any() const { return Mask() != 0; }
+};
+
+/// 8 float lanes. Comparisons return lane masks with all bits set or cleared.
+class Float8
+{
+public:
+    static constexpr unsigned SIZE = 8;
+
+#if defined(PT_SIMD_AVX2)
+    __m256 v;
+
+    Float8()
+    {
+    }
+
+    Float8(__m256 value) :
+        v(value)
+    {
+    }
+
+    /// Broadcast to all lanes.
+    Float8(float value) :
+        v(_mm256_set1_ps(value))
+    {
+    }
+
+    static Float8 Load(const float* data) { return _mm256_loadu_ps(data); }
+    static Float8 LoadAligned(const float* data) { return _mm256_load_ps(data); }
+    void Store(float* data) const { _mm256_storeu_ps(data, v); }
+    void StoreAligned(float* data) const { _mm256_store_ps(data, v); }
+
+    Float8 operator + (const Float8& rhs) const { return _mm256_add_ps(v, rhs.v); }
+    Float8 operator - (const Float8& rhs) const { return _mm256_sub_ps(v, rhs.v); }
+    Float8 operator * (const Float8& rhs) const { return _mm256_mul_ps(v, rhs.v); }
+    Float8 operator / (const Float8& rhs) const { return _mm256_div_ps(v, rhs.v); }
+    Float8 operator - () const { return _mm256_sub_ps(_mm256_setzero_ps(), v); }
+
+    Float8 operator < (const Float8& rhs) const { return _mm256_cmp_ps(v, rhs.v, _CMP_LT_OQ); }
+    Float8 operator <= (const Float8& rhs) const { return _mm256_cmp_ps(v, rhs.v, _CMP_LE_OQ); }
+    Float8 operator > (const Float8& rhs) const { return _mm256_cmp_ps(v, rhs.v, _CMP_GT_OQ); }
+    Float8 operator >= (const Float8& rhs) const { return _mm256_cmp_ps(v, rhs.v, _CMP_GE_OQ); }
+    Float8 operator & (const Float8& rhs) const { return _mm256_and_ps(v, rhs.v); }
+    Float8 operator | (const Float8& rhs) const { return _mm256_or_ps(v, rhs.v); }
+
+    /// Return bit per lane with the lane mask.
+    int Mask() const { return _mm256_movemask_ps(v); }
+
+    static Float8 Min(const Float8& lhs, const Float8& rhs) { return _mm256_min_ps(lhs.v, rhs.v); }
+    static Float8 Max(const Float8& lhs, const Float8& rhs) { return _mm256_max_ps(lhs.v, rhs.v); }
+    /// Return lanes of lhs where mask is set, otherwise rhs.
+    static Float8 Select(const Float8& mask, const Float8& lhs, const Float8& rhs) { return _mm256_blendv_ps(rhs.v, lhs.v, mask.v); }
+    static Float8 Abs(const Float8& value) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value.v); }
+    static Float8 Sqrt(const Float8& value) { return _mm256_sqrt_ps(value.v); }
+#else
+    /// Without AVX2 the lanes are processed as two 4-wide halves.
+    Float4 low;
+    Float4 high;
+
+    Float8()
+    {
+    }
+
+    Float8(const Float4& low_, const Float4& high_) :
+        low(low_),
+        high(high_)
+    {
+    }
+
+    /// Broadcast to all lanes.
+    Float8(float value) :
+        low(value),
+        high(value)
+    {
+    }
+
+    static Float8 Load(const float* data) { return Float8(Float4::Load(data), Float4::Load(data + 4)); }
+    static Float8 LoadAligned(const float* data) { return Float8(Float4::LoadAligned(data), Float4::LoadAligned(data + 4)); }
+    void Store(float* data) const { low.Store(data); high.Store(data + 4); }
+    void StoreAligned(float* data) const { low.StoreAligned(data); high.StoreAligned(data + 4); }
+
+    Float8 operator + (const Float8& rhs) const { return Float8(low + rhs.low, high + rhs.high); }
+    Float8 operator - (const Float8& rhs) const { return Float8(low - rhs.low, high - rhs.high); }
+    Float8 operator * (const Float8& rhs) const { return Float8(low * rhs.low, high * rhs.high); }
+    Float8 operator / (const Float8& rhs) const { return Float8(low / rhs.low, high / rhs.high); }
+    Float8 operator - () const { return Float8(-low, -high); }
+
+    Float8 operator < (const Float8& rhs) const { return Float8(low < rhs.low, high < rhs.high); }
+    Float8 operator <= (const Float8& rhs) const { return Float8(low <= rhs.low, high <= rhs.high); }
+    Float8 operator > (const Float8& rhs) const { return Float8(low > rhs.low, high > rhs.high); }
+    Float8 operator >= (const Float8& rhs) const { return Float8(low >= rhs.low, high >= rhs.high); }
+    Float8 operator & (const Float8& rhs) const { return Float8(low & rhs.low, high & rhs.high); }
+    Float8 operator | (const Float8& rhs) const { return Float8(low | rhs.low, high | rhs.high); }
+
+    /// Return bit per lane with the lane mask.
+    int Mask() const { return low.Mask() | (high.Mask() << 4); }
+
+    static Float8 Min(const Float8& lhs, const Float8& rhs) { return Float8(Float4::Min(lhs.low, rhs.low), Float4::Min(lhs.high, rhs.high)); }
+    static Float8 Max(const Float8& lhs, const Float8& rhs) { return Float8(Float4::Max(lhs.low, rhs.low), Float4::Max(lhs.high, rhs.high)); }
+    /// Return lanes of lhs where mask is set, otherwise rhs.
+    static Float8 Select(const Float8& mask, const Float8& lhs, const Float8& rhs) { return Float8(Float4::Select(mask.low, lhs.low, rhs.low), Float4::Select(mask.high, lhs.high, rhs.high)); }
+    static Float8 Abs(const Float8& value) { return Float8(Float4::Abs(value.low), Float4::Abs(value.high)); }
+    static Float8 Sqrt(const Float8& value) { return Float8(Float4::Sqrt(value.low), Float4::Sqrt(value.high)); }
+#endif
+
+    /// Return value of one lane.
+    float Lane(unsigned index) const
+    {
+        float data[SIZE];
+        Store(data);
+        return data[index];
+    }
+    /// Return true if any lane mask is set.
+    bool Any() const { return Mask() != 0; }
+};
+
+/// Widest float lanes of the target instruction set.
+#if defined(PT_SIMD_AVX2)
+using FloatN = Float8;
+#else
+using FloatN = Float4;
+#endif
+
+} // namespace Pt
@@ -1,9 +1,29 @@
 #include "Transform.hpp"
 
+#include <algorithm>
+
+#include "Thread/JobSystem.hpp"
+
 #include "Math.hpp"
+#include "SIMD.hpp"
 
 namespace Pt {
 
+/// Arrays at least this long are split into jobs.
+static const size_t PARALLEL_THRESHOLD = 16384;
+/// Items per job, a whole number of SIMD blocks.
+static const size_t PARALLEL_GRAIN_SIZE = 4096;
+
+/// Call function(begin, end) over the whole array, split across the job system if it is large.
+template <typename F> static void ForEachRange(size_t count, F function)
+{
+    JobSystem* jobSystem = count >= PARALLEL_THRESHOLD ? Object::Subsystem<JobSystem>() : nullptr;
+    if (jobSystem)
+        jobSystem->ParallelFor(0, count, PARALLEL_GRAIN_SIZE, function);
+    else
+        function(size_t(0), count);
+}
+
 Matrix3 ScaleMatrix3(const Vector3& scale)
 {
     Matrix3 ret = Matrix3::IDENTITY;
@@ -139,6 +159,161 @@ Matrix4 TranslateMatrix4(float x, float y, float z)
     return TranslateMatrix4(Vector3{x, y, z});
 }
 
+Matrix3 TransformMatrix3(const Vector3& rotaion, const Vector3& scale)
+{
+    return RotationMatrix3(rotaion) * ScaleMatrix3(scale);
+}
+
+Matrix3 TransformMatrix3(const Vector3& rotaion, float scale)
+{
+    return RotationMatrix3(rotaion) * ScaleMatrix3(scale);
+}
+
+Matrix4 TransformMatrix4(const Vector3& rotation, const Vector3& scale, const Vector3& translation)
+{
+    Matrix4 ret = TransformMatrix3(rotation, scale);
+    ret.data[3][0] = translation.x;
+    ret.data[3][1] = translation.y;
+    ret.data[3][2] = translation.z;
+    return ret;
+}
+
+Matrix4 TransformMatrix4(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
+{
+    Matrix4 ret = rotation.ToMatrix() * ScaleMatrix3(scale);
+    ret.data[3][0] = translation.x;
+    ret.data[3][1] = translation.y;
+    ret.data[3][2] = translation.z;
+    return ret;
+}
+
+Matrix4 TransformMatrix4(const Vector3& rotation, float scale, const Vector3& translation)
+{
+    return TransformMatrix4(rotation, Vector3{scale, scale, scale}, translation);
+}
+
+void TransformMatrices(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix4* outMatrices, size_t count)
+{
+    ForEachRange(count, [=](size_t begin, size_t end)
+    {
+        const Float4 zero(0.0f);
+        const Float4 one(1.0f);
+
+        // 4 instances at a time, one per lane. Inputs past the end repeat the first lane.
+        for (size_t i = begin; i < end; i += Float4::SIZE)
+        {
+            unsigned lanes = static_cast<unsigned>(std::min<size_t>(Float4::SIZE, end - i));
+            size_t i1 = lanes > 1 ? i + 1 : i;
+            size_t i2 = lanes > 2 ? i + 2 : i;
+            size_t i3 = lanes > 3 ? i + 3 : i;
+
+            Float4 w = Float4::Load(rotations[i].data);
+            Float4 x = Float4::Load(rotations[i1].data);
+            Float4 y = Float4::Load(rotations[i2].data);
+            Float4 z = Float4::Load(rotations[i3].data);
+            Float4::Transpose(w, x, y, z);
+            Float4 x2 = x + x;
+            Float4 y2 = y + y;
+            Float4 z2 = z + z;
+            Float4 xx = x * x2, yy = y * y2, zz = z * z2;
+            Float4 xy = x * y2, xz = x * z2, yz = y * z2;
+            Float4 wx = w * x2, wy = w * y2, wz = w * z2;
+
+            Float4 scaleX(scales[i].x, scales[i1].x, scales[i2].x, scales[i3].x);
+            Float4 scaleY(scales[i].y, scales[i1].y, scales[i2].y, scales[i3].y);
+            Float4 scaleZ(scales[i].z, scales[i1].z, scales[i2].z, scales[i3].z);
+
+            // Lane i of columns[c][r] is row r of column c of matrix i. Rotation matches Quaternion::ToMatrix().
+            Float4 columns[4][4] = {
+                { (one - yy - zz) * scaleX, (xy - wz) * scaleX, (xz + wy) * scaleX, zero },
+                { (xy + wz) * scaleY, (one - xx - zz) * scaleY, (yz - wx) * scaleY, zero },
+                { (xz - wy) * scaleZ, (yz + wx) * scaleZ, (one - xx - yy) * scaleZ, zero },
+                {
+                    Float4(translations[i].x, translations[i1].x, translations[i2].x, translations[i3].x),
+                    Float4(translations[i].y, translations[i1].y, translations[i2].y, translations[i3].y),
+                    Float4(translations[i].z, translations[i1].z, translations[i2].z, translations[i3].z),
+                    one
+                }
+            };
+
+            for (unsigned c = 0; c < 4; ++c)
+            {
+                Float4::Transpose(columns[c][0], columns[c][1], columns[c][2], columns[c][3]);
+                for (unsigned lane = 0; lane < lanes; ++lane)
+                    columns[c][lane].StoreAligned(outMatrices[i + lane].data[c]);
+            }
+        }
+    });
+}
+
+void TransformPoints(const Matrix4& matrix, const Vector3* points, Vector3* outPoints, size_t count)
+{
+    ForEachRange(count, [=, &matrix](size_t begin, size_t end)
+    {
+        const Float4 c0 = Float4::LoadAligned(matrix.data[0]);
+        const Float4 c1 = Float4::LoadAligned(matrix.data[1]);
+        const Float4 c2 = Float4::LoadAligned(matrix.data[2]);
+        const Float4 c3 = Float4::LoadAligned(matrix.data[3]);
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            const Vector3& point = points[i];
+            alignas(16) float data[Float4::SIZE];
+            (c0 * Float4(point.x) + c1 * Float4(point.y) + c2 * Float4(point.z) + c3).StoreAligned(data);
+            outPoints[i] = Vector3(data[0], data[1], data[2]);
+        }
+    });
+}
+
+void TransformNormals(const Matrix4& matrix, const Vector3* normals, Vector3* outNormals, size_t count)
+{
+    Vector3 c0(matrix.data[0][0], matrix.data[0][1], matrix.data[0][2]);
+    Vector3 c1(matrix.data[1][0], matrix.data[1][1], matrix.data[1][2]);
+    Vector3 c2(matrix.data[2][0], matrix.data[2][1], matrix.data[2][2]);
+
+    // Columns of the inverse transpose up to scale. Only the determinant sign is kept as results are normalized.
+    float sign = c0.Dot(c1.Cross(c2)) < 0.0f ? -1.0f : 1.0f;
+    Vector3 n0 = c1.Cross(c2) * sign;
+    Vector3 n1 = c2.Cross(c0) * sign;
+    Vector3 n2 = c0.Cross(c1) * sign;
+
+    ForEachRange(count, [=](size_t begin, size_t end)
+    {
+        const Float4 m[3][3] = {
+            { Float4(n0.x), Float4(n0.y), Float4(n0.z) },
+            { Float4(n1.x), Float4(n1.y), Float4(n1.z) },
+            { Float4(n2.x), Float4(n2.y), Float4(n2.z) }
+        };
+        const Float4 minLengthSquared(1e-30f);
+
+        for (size_t i = begin; i < end; i += Float4::SIZE)
+        {
+            unsigned lanes = static_cast<unsigned>(std::min<size_t>(Float4::SIZE, end - i));
+            const Vector3& a0 = normals[i];
+            const Vector3& a1 = normals[lanes > 1 ? i + 1 : i];
+            const Vector3& a2 = normals[lanes > 2 ? i + 2 : i];
+            const Vector3& a3 = normals[lanes > 3 ? i + 3 : i];
+
+            Float4 x(a0.x, a1.x, a2.x, a3.x);
+            Float4 y(a0.y, a1.y, a2.y, a3.y);
+            Float4 z(a0.z, a1.z, a2.z, a3.z);
+            Float4 outX = m[0][0] * x + m[1][0] * y + m[2][0] * z;
+            Float4 outY = m[0][1] * x + m[1][1] * y + m[2][1] * z;
+            Float4 outZ = m[0][2] * x + m[1][2] * y + m[2][2] * z;
+            Float4 invLength = Float4(1.0f) / Float4::Sqrt(Float4::Max(outX * outX + outY * outY + outZ * outZ, minLengthSquared));
+            Float4 results[4] = { outX * invLength, outY * invLength, outZ * invLength, Float4(0.0f) };
+            Float4::Transpose(results[0], results[1], results[2], results[3]);
+
+            for (unsigned lane = 0; lane < lanes; ++lane)
+            {
+                alignas(16) float data[Float4::SIZE];
+                results[lane].StoreAligned(data);
+                outNormals[i + lane] = Vector3(data[0], data[1], data[2]);
+            }
+        }
+    });
+}
+
 bool DecomposeSRT(const Matrix4 &matrix, Vector3 &scale, Vector3 &rotation, Vector3 &translation)
 {
     Matrix4 localMatrix = matrix;
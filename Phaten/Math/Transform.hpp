@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include "Matrix.hpp"
 #include "Quaternion.hpp"
 
@@ -29,10 +31,17 @@ Matrix4 TranslateMatrix4(const Vector3& translation);
 Matrix4 TranslateMatrix4(float x, float y, float z);
 
 Matrix4 TransformMatrix4(const Vector3& rotation, const Vector3& scale, const Vector3& translation);
-// Matrix4 TransformMatrix4(const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
+Matrix4 TransformMatrix4(const Vector3& translation, const Quaternion& rotation, const Vector3& scale);
 Matrix4 TransformMatrix4(const Vector3& rotation, float scale, const Vector3& translation);
 // Matrix4 TransformMatrix4(const Vector3& translation, const Quaternion& rotation, float scale);
 
+/// Compose translation * rotation * scale world matrices from component arrays. Rotations must be normalized.
+void TransformMatrices(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix4* outMatrices, size_t count);
+/// Transform points by an affine matrix. Input and output may be the same array.
+void TransformPoints(const Matrix4& matrix, const Vector3* points, Vector3* outPoints, size_t count);
+/// Transform normals by the inverse transpose of an affine matrix and normalize them. Input and output may be the same array.
+void TransformNormals(const Matrix4& matrix, const Vector3* normals, Vector3* outNormals, size_t count);
+
 // FIXME
 bool DecomposeSRT(const Matrix4& matrix, Vector3& scale, Vector3& rotation, Vector3& translation);
 
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "SIMD.hpp"
+#include "Vector.hpp"
+
+namespace Pt {
+
+/// Structure of arrays Vector3, one vector per lane of T (Float4 or Float8).
+template <typename T>
+class Vector3SoA
+{
+public:
+    T x;
+    T y;
+    T z;
+
+    Vector3SoA()
+    {
+    }
+
+    Vector3SoA(const T& x_, const T& y_, const T& z_) :
+        x(x_),
+        y(y_),
+        z(z_)
+    {
+    }
+
+    /// Broadcast a vector to all lanes.
+    Vector3SoA(const Vector3& vector) :
+        x(vector.x),
+        y(vector.y),
+        z(vector.z)
+    {
+    }
+
+    Vector3SoA operator + (const Vector3SoA& rhs) const { return Vector3SoA(x + rhs.x, y + rhs.y, z + rhs.z); }
+    Vector3SoA operator - (const Vector3SoA& rhs) const { return Vector3SoA(x - rhs.x, y - rhs.y, z - rhs.z); }
+    Vector3SoA operator * (const Vector3SoA& rhs) const { return Vector3SoA(x * rhs.x, y * rhs.y, z * rhs.z); }
+    Vector3SoA operator * (const T& rhs) const { return Vector3SoA(x * rhs, y * rhs, z * rhs); }
+
+    T Dot(const Vector3SoA& rhs) const { return x * rhs.x + y * rhs.y + z * rhs.z; }
+    Vector3SoA Cross(const Vector3SoA& rhs) const { return Vector3SoA(y * rhs.z - z * rhs.y, z * rhs.x - x * rhs.z, x * rhs.y - y * rhs.x); }
+
+    /// Return vector of one lane.
+    Vector3 Lane(unsigned index) const { return Vector3(x.Lane(index), y.Lane(index), z.Lane(index)); }
+};
+
+using Vector3x4 = Vector3SoA<Float4>;
+using Vector3x8 = Vector3SoA<Float8>;
+
+} // namespace Pt
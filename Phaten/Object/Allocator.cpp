@@ -1,20 +1,55 @@
 #include "Allocator.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "IO/Logger.hpp"
 
 namespace Pt {
 
-static AllocatorBlock* AllocatorGetBlock(AllocatorBlock* allocator, size_t nodeSize, size_t capacity)
+/// Return alignment of nodes. Free nodes store a link, so they are at least pointer aligned.
+static size_t NodeAlignment(size_t alignment)
+{
+    assert(alignment && !(alignment & (alignment - 1))); // Alignment must be a power of two
+    return std::max(alignment, alignof(AllocatorNode));
+}
+
+/// Return distance between nodes, object size rounded up to alignment.
+static size_t NodeStride(size_t nodeSize, size_t alignment)
+{
+    size_t size = std::max(nodeSize, sizeof(AllocatorNode));
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+/// Return offset of the first node, header rounded up to alignment.
+static size_t HeaderSize(size_t alignment)
+{
+    return (sizeof(AllocatorBlock) + alignment - 1) & ~(alignment - 1);
+}
+
+static AllocatorBlock* AllocatorGetBlock(AllocatorBlock* allocator, size_t nodeSize, size_t alignment, size_t capacity)
 {
     if (!capacity)
         capacity = 1; // Avoid 0
 
-    unsigned char* blockPtr = new unsigned char[sizeof(AllocatorBlock) + capacity * (sizeof(AllocatorNode) + nodeSize)];
+    size_t stride = NodeStride(nodeSize, alignment);
+    unsigned char* blockPtr = static_cast<unsigned char*>(::operator new(HeaderSize(alignment) + capacity * stride, std::align_val_t(alignment)));
     AllocatorBlock* newBlock = reinterpret_cast<AllocatorBlock*>(blockPtr);
     newBlock->nodeSize = nodeSize;
+    newBlock->alignment = alignment;
     newBlock->capacity = capacity;
+    newBlock->blockCapacity = capacity;
     newBlock->free = nullptr;
     newBlock->next = nullptr;
+    newBlock->name = nullptr;
+    newBlock->numBlocks = 1;
+    newBlock->liveNodes = 0;
+    newBlock->peakNodes = 0;
+    newBlock->allocations = 0;
+    newBlock->reportedAllocations = 0;
 
     // Set newBlock as head of the linked list
     if (!allocator)
@@ -23,17 +58,18 @@ static AllocatorBlock* AllocatorGetBlock(AllocatorBlock* allocator, size_t nodeS
     {
         newBlock->next = allocator->next;
         allocator->next = newBlock;
+        ++allocator->numBlocks;
     }
 
-    // Intialize nodes
-    unsigned char* nodePtr = blockPtr + sizeof(AllocatorBlock);
+    // Intialize nodes, the link lives in the node itself while it is free
+    unsigned char* nodePtr = blockPtr + HeaderSize(alignment);
     AllocatorNode* firstNewNode = reinterpret_cast<AllocatorNode*>(nodePtr);
 
     for (size_t i = 0; i < capacity - 1; ++i)
     {
         AllocatorNode* newNode = reinterpret_cast<AllocatorNode*>(nodePtr);
-        newNode->next = reinterpret_cast<AllocatorNode*>(nodePtr + sizeof(AllocatorNode) + nodeSize);
-        nodePtr += sizeof(AllocatorNode) + nodeSize;
+        newNode->next = reinterpret_cast<AllocatorNode*>(nodePtr + stride);
+        nodePtr += stride;
     }
     // handle the last node
     {
@@ -45,20 +81,190 @@ static AllocatorBlock* AllocatorGetBlock(AllocatorBlock* allocator, size_t nodeS
     return newBlock;
 }
 
-AllocatorBlock* AllocatorInitialize(size_t nodeSize, size_t initialCapacity)
+/// Free a chain of blocks without touching statistics.
+static void AllocatorFreeBlocks(AllocatorBlock* block)
+{
+    while (block)
+    {
+        AllocatorBlock* next = block->next;
+        ::operator delete(block, std::align_val_t(block->alignment));
+        block = next;
+    }
+}
+
+/// Return the node range of a block.
+static unsigned char* BlockNodesBegin(AllocatorBlock* block)
+{
+    return reinterpret_cast<unsigned char*>(block) + HeaderSize(block->alignment);
+}
+
+static unsigned char* BlockNodesEnd(AllocatorBlock* block)
+{
+    return BlockNodesBegin(block) + block->blockCapacity * NodeStride(block->nodeSize, block->alignment);
+}
+
+/// Return index of the block containing node in blocks sorted by address.
+static size_t FindBlock(const std::vector<AllocatorBlock*>& sorted, AllocatorNode* node)
+{
+    auto it = std::upper_bound(sorted.begin(), sorted.end(), reinterpret_cast<uintptr_t>(node),
+        [](uintptr_t address, AllocatorBlock* block) { return address < reinterpret_cast<uintptr_t>(block); });
+    return static_cast<size_t>(it - sorted.begin()) - 1;
+}
+
+/// Free blocks of the chain whose nodes are all in the free list, except keep, and remove their nodes from the list.
+/// Return numbers of Nodes released.
+static size_t AllocatorTrimBlocks(AllocatorBlock*& blocks, const AllocatorBlock* keep, AllocatorNode*& free, size_t& numBlocks)
+{
+    std::vector<AllocatorBlock*> sorted;
+    for (AllocatorBlock* block = blocks; block; block = block->next)
+        sorted.push_back(block);
+    std::sort(sorted.begin(), sorted.end(), [](AllocatorBlock* lhs, AllocatorBlock* rhs) {
+        return reinterpret_cast<uintptr_t>(lhs) < reinterpret_cast<uintptr_t>(rhs);
+    });
+
+    std::vector<size_t> numFree(sorted.size(), 0);
+    for (AllocatorNode* node = free; node; node = node->next)
+    {
+        size_t index = FindBlock(sorted, node);
+        assert(reinterpret_cast<unsigned char*>(node) < BlockNodesEnd(sorted[index])); // Free list holds a foreign node
+        ++numFree[index];
+    }
+
+    std::vector<bool> empty(sorted.size(), false);
+    bool anyEmpty = false;
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        empty[i] = sorted[i] != keep && numFree[i] == sorted[i]->blockCapacity;
+        anyEmpty |= empty[i];
+    }
+    if (!anyEmpty)
+        return 0;
+
+    // Relink the free list without nodes of empty blocks, keeping order.
+    AllocatorNode* kept = nullptr;
+    AllocatorNode** tail = &kept;
+    for (AllocatorNode* node = free; node; node = node->next)
+    {
+        if (!empty[FindBlock(sorted, node)])
+        {
+            *tail = node;
+            tail = &node->next;
+        }
+    }
+    *tail = nullptr;
+    free = kept;
+
+    size_t released = 0;
+    for (AllocatorBlock** link = &blocks; *link;)
+    {
+        AllocatorBlock* block = *link;
+        size_t index = std::lower_bound(sorted.begin(), sorted.end(), block, [](AllocatorBlock* lhs, AllocatorBlock* rhs) {
+            return reinterpret_cast<uintptr_t>(lhs) < reinterpret_cast<uintptr_t>(rhs);
+        }) - sorted.begin();
+
+        if (empty[index])
+        {
+            *link = block->next;
+            released += block->blockCapacity;
+            --numBlocks;
+            ::operator delete(block, std::align_val_t(block->alignment));
+        }
+        else
+            link = &block->next;
+    }
+
+    return released;
+}
+
+/// Return bytes taken by blocks holding capacity nodes in total.
+static size_t BytesReserved(size_t numBlocks, size_t capacity, size_t nodeSize, size_t alignment)
+{
+    return numBlocks * HeaderSize(alignment) + capacity * NodeStride(nodeSize, alignment);
+}
+
+/// Print objects still alive when an allocator is destroyed. Uses stdio, the logger may already be gone during shutdown.
+static void ReportLeaks(const char* name, size_t nodeSize, int64_t liveNodes)
+{
+    if (liveNodes > 0)
+        std::fprintf(stderr, "[Allocator] %s destroyed with %lld live objects of %zu bytes\n",
+            name ? name : "Unnamed", static_cast<long long>(liveNodes), nodeSize);
+}
+
+/// Nodes moved between a thread cache and the shared free nodes at once.
+static const size_t CONCURRENT_BATCH_SIZE = 64;
+/// Most free nodes a thread keeps. A batch goes back to the shared free nodes above it.
+static const size_t CONCURRENT_CACHE_SIZE = 256;
+/// Most nodes added by one new block, so a thread running empty does not reserve half the capacity.
+static const size_t CONCURRENT_MAX_GROW = 16 * CONCURRENT_BATCH_SIZE;
+/// Allocations or frees a thread counts locally before adding them to the shared statistics.
+static const int64_t CONCURRENT_STATS_INTERVAL = 64;
+
+/// Nodes owned by one thread for one concurrent allocator.
+struct ConcurrentAllocatorCache
+{
+    ConcurrentAllocatorBlock* allocator = nullptr;
+    /// Zero if unused.
+    uint64_t id = 0;
+    /// Free nodes of this thread, most recently freed first.
+    AllocatorNode* nodes = nullptr;
+    size_t numNodes = 0;
+    /// Live node and allocation counts not yet added to the allocator.
+    int64_t pendingLive = 0;
+    int64_t pendingAllocations = 0;
+};
+
+/// All initialized allocators.
+struct AllocatorRegistry
+{
+    std::mutex mutex;
+    /// Plain allocators by first block.
+    std::vector<AllocatorBlock*> allocators;
+    /// Concurrent allocators by slot, null if the slot is free.
+    std::vector<ConcurrentAllocatorBlock*> slots;
+    uint64_t nextId = 1;
+    /// Time of the last LogAllocatorStats().
+    std::chrono::steady_clock::time_point lastReport = std::chrono::steady_clock::now();
+};
+
+/// Constructed on first use, static allocators are initialized before main. Never destroyed, allocators in
+/// other static objects may be destroyed after it otherwise.
+static AllocatorRegistry& GetRegistry()
+{
+    static AllocatorRegistry* registry = new AllocatorRegistry();
+    return *registry;
+}
+
+AllocatorBlock* AllocatorInitialize(size_t nodeSize, size_t initialCapacity, const char* name, size_t alignment)
 {
-    AllocatorBlock* block = AllocatorGetBlock(nullptr, nodeSize, initialCapacity);
+    AllocatorBlock* block = AllocatorGetBlock(nullptr, nodeSize, NodeAlignment(alignment), initialCapacity);
+    block->name = name;
+
+    AllocatorRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.allocators.push_back(block);
     return block;
 }
 
 void AllocatorUninitialize(AllocatorBlock *allocator)
 {
-    while (allocator)
+    if (!allocator)
+        return;
+
     {
-        AllocatorBlock* next = allocator->next;
-        delete[] reinterpret_cast<unsigned char*>(allocator);
-        allocator = next;
+        AllocatorRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (size_t i = 0; i < registry.allocators.size(); ++i)
+        {
+            if (registry.allocators[i] == allocator)
+            {
+                registry.allocators.erase(registry.allocators.begin() + i);
+                break;
+            }
+        }
     }
+
+    ReportLeaks(allocator->name, allocator->nodeSize, static_cast<int64_t>(allocator->liveNodes));
+    AllocatorFreeBlocks(allocator);
 }
 
 void* AllocatorGet(AllocatorBlock* allocator)
@@ -69,14 +275,17 @@ void* AllocatorGet(AllocatorBlock* allocator)
     if (!allocator->free)
     {
         size_t newCapacity = (allocator->capacity + 1) >> 1;
-        AllocatorGetBlock(allocator, allocator->nodeSize, newCapacity);
+        AllocatorGetBlock(allocator, allocator->nodeSize, allocator->alignment, newCapacity);
         allocator->capacity += newCapacity;
     }
 
     AllocatorNode* freeNode = allocator->free;
-    void* ptr = (reinterpret_cast<unsigned char*>(freeNode) + sizeof(AllocatorNode));
+    void* ptr = freeNode;
     allocator->free = freeNode->next;
-    freeNode->next = nullptr;
+
+    ++allocator->allocations;
+    if (++allocator->liveNodes > allocator->peakNodes)
+        allocator->peakNodes = allocator->liveNodes;
 
     return ptr;
 }
@@ -86,13 +295,439 @@ void AllocatorFree(AllocatorBlock* allocator, void* ptr)
     if (!allocator || !ptr)
         return;
 
-    unsigned char* dataPtr = static_cast<unsigned char*>(ptr);
-    AllocatorNode* node = reinterpret_cast<AllocatorNode*>(dataPtr - sizeof(AllocatorNode));
-
-    assert(!node->next); // Potential illegal free of object not allocated via the allocator
-
+    AllocatorNode* node = static_cast<AllocatorNode*>(ptr);
     node->next = allocator->free;
     allocator->free = node;
+    --allocator->liveNodes;
+}
+
+size_t AllocatorTrim(AllocatorBlock* allocator)
+{
+    if (!allocator)
+        return 0;
+
+    // The first block is the handle of the allocator and holds the statistics, it is never released.
+    AllocatorBlock* blocks = allocator;
+    size_t released = AllocatorTrimBlocks(blocks, allocator, allocator->free, allocator->numBlocks);
+    allocator->capacity -= released;
+    return released;
+}
+
+/// Add a chain of nodes to the shared free nodes, filling batches. Must hold the allocator mutex.
+static void PushFreeNodes(ConcurrentAllocatorBlock* allocator, AllocatorNode* chain)
+{
+    while (chain)
+    {
+        AllocatorNode* node = chain;
+        chain = chain->next;
+
+        node->next = allocator->partial;
+        allocator->partial = node;
+        if (++allocator->numPartial == CONCURRENT_BATCH_SIZE)
+        {
+            allocator->batches.push_back(allocator->partial);
+            allocator->partial = nullptr;
+            allocator->numPartial = 0;
+        }
+    }
+}
+
+/// Add counts to the shared statistics of a concurrent allocator.
+static void AddConcurrentStats(ConcurrentAllocatorBlock* allocator, int64_t live, int64_t allocations)
+{
+    int64_t liveNodes = allocator->liveNodes.fetch_add(live, std::memory_order_relaxed) + live;
+    allocator->allocations.fetch_add(allocations, std::memory_order_relaxed);
+
+    int64_t peakNodes = allocator->peakNodes.load(std::memory_order_relaxed);
+    while (liveNodes > peakNodes && !allocator->peakNodes.compare_exchange_weak(peakNodes, liveNodes, std::memory_order_relaxed))
+    {
+    }
+}
+
+/// Add the counts kept by a thread cache to the shared statistics.
+static void PublishCacheStats(ConcurrentAllocatorCache& cache)
+{
+    if (cache.pendingLive || cache.pendingAllocations)
+    {
+        AddConcurrentStats(cache.allocator, cache.pendingLive, cache.pendingAllocations);
+        cache.pendingLive = 0;
+        cache.pendingAllocations = 0;
+    }
+}
+
+/// Set when the caches of the calling thread are gone, e.g. during static destruction after main returned.
+static thread_local bool sThreadCachesDestroyed = false;
+
+/// Caches of the calling thread, returned to their allocators at thread exit.
+struct ConcurrentAllocatorThreadCaches
+{
+    ~ConcurrentAllocatorThreadCaches()
+    {
+        sThreadCachesDestroyed = true;
+        AllocatorRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (size_t i = 0; i < caches.size() && i < registry.slots.size(); ++i)
+        {
+            // Skip caches of allocators that were uninitialized, their memory is gone.
+            ConcurrentAllocatorCache& cache = caches[i];
+            ConcurrentAllocatorBlock* allocator = cache.allocator;
+            if (!cache.id || registry.slots[i] != allocator || allocator->id != cache.id)
+                continue;
+
+            PublishCacheStats(cache);
+            std::lock_guard<std::mutex> blockLock(allocator->mutex);
+            PushFreeNodes(allocator, cache.nodes);
+        }
+    }
+
+    /// Indexed by allocator slot.
+    std::vector<ConcurrentAllocatorCache> caches;
+};
+
+static thread_local ConcurrentAllocatorThreadCaches sThreadCaches;
+
+static ConcurrentAllocatorCache& GetThreadCache(ConcurrentAllocatorBlock* allocator)
+{
+    std::vector<ConcurrentAllocatorCache>& caches = sThreadCaches.caches;
+    if (allocator->slot >= caches.size())
+        caches.resize(allocator->slot + 1);
+
+    ConcurrentAllocatorCache& cache = caches[allocator->slot];
+    if (cache.id != allocator->id)
+    {
+        // Left over from an uninitialized allocator in the same slot, drop it.
+        cache = ConcurrentAllocatorCache();
+        cache.allocator = allocator;
+        cache.id = allocator->id;
+    }
+
+    return cache;
+}
+
+/// Publish the calling thread's counts for an allocator, so single threaded use reports exact numbers.
+static void PublishThreadStats(ConcurrentAllocatorBlock* allocator)
+{
+    if (sThreadCachesDestroyed)
+        return;
+
+    std::vector<ConcurrentAllocatorCache>& caches = sThreadCaches.caches;
+    if (allocator->slot < caches.size() && caches[allocator->slot].id == allocator->id)
+        PublishCacheStats(caches[allocator->slot]);
+}
+
+/// Allocate a block of nodes and add them to the shared free nodes. Must hold the allocator mutex.
+static void ConcurrentAllocatorGetBlock(ConcurrentAllocatorBlock* allocator, size_t capacity)
+{
+    AllocatorBlock* block = AllocatorGetBlock(nullptr, allocator->nodeSize, allocator->alignment, capacity);
+    AllocatorNode* nodes = block->free;
+    block->free = nullptr;
+    block->next = allocator->blocks;
+    allocator->blocks = block;
+    allocator->capacity += block->blockCapacity;
+    ++allocator->numBlocks;
+
+    PushFreeNodes(allocator, nodes);
+}
+
+/// Take a batch of shared free nodes, or fewer if no batch is full. Grow by a bounded block if there are none.
+/// Must hold the allocator mutex.
+static AllocatorNode* PopFreeNodes(ConcurrentAllocatorBlock* allocator, size_t& count)
+{
+    if (allocator->batches.empty() && !allocator->partial)
+    {
+        size_t capacity = std::clamp((allocator->capacity + 1) >> 1, CONCURRENT_BATCH_SIZE, CONCURRENT_MAX_GROW);
+        ConcurrentAllocatorGetBlock(allocator, capacity);
+    }
+
+    AllocatorNode* nodes;
+    if (!allocator->batches.empty())
+    {
+        nodes = allocator->batches.back();
+        allocator->batches.pop_back();
+        count = CONCURRENT_BATCH_SIZE;
+    }
+    else
+    {
+        nodes = allocator->partial;
+        count = allocator->numPartial;
+        allocator->partial = nullptr;
+        allocator->numPartial = 0;
+    }
+
+    return nodes;
+}
+
+ConcurrentAllocatorBlock* ConcurrentAllocatorInitialize(size_t nodeSize, size_t initialCapacity, const char* name, size_t alignment)
+{
+    ConcurrentAllocatorBlock* allocator = new ConcurrentAllocatorBlock();
+    allocator->nodeSize = nodeSize;
+    allocator->alignment = NodeAlignment(alignment);
+    allocator->capacity = 0;
+    allocator->name = name;
+    allocator->numBlocks = 0;
+    allocator->liveNodes.store(0, std::memory_order_relaxed);
+    allocator->peakNodes.store(0, std::memory_order_relaxed);
+    allocator->allocations.store(0, std::memory_order_relaxed);
+    allocator->reportedAllocations = 0;
+    allocator->partial = nullptr;
+    allocator->numPartial = 0;
+    allocator->blocks = nullptr;
+    ConcurrentAllocatorGetBlock(allocator, initialCapacity);
+
+    AllocatorRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    allocator->id = registry.nextId++;
+    allocator->slot = static_cast<unsigned>(registry.slots.size());
+    for (unsigned i = 0; i < registry.slots.size(); ++i)
+    {
+        if (!registry.slots[i])
+        {
+            allocator->slot = i;
+            break;
+        }
+    }
+    if (allocator->slot == registry.slots.size())
+        registry.slots.push_back(allocator);
+    else
+        registry.slots[allocator->slot] = allocator;
+
+    return allocator;
+}
+
+void ConcurrentAllocatorUninitialize(ConcurrentAllocatorBlock* allocator)
+{
+    if (!allocator)
+        return;
+
+    {
+        AllocatorRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.slots[allocator->slot] = nullptr;
+    }
+
+    PublishThreadStats(allocator);
+    ReportLeaks(allocator->name, allocator->nodeSize, allocator->liveNodes.load(std::memory_order_relaxed));
+    AllocatorFreeBlocks(allocator->blocks);
+    delete allocator;
+}
+
+void* ConcurrentAllocatorGet(ConcurrentAllocatorBlock* allocator)
+{
+    if (!allocator)
+        return nullptr;
+
+    if (sThreadCachesDestroyed)
+    {
+        // Take a batch, keep one node and put the rest back.
+        AllocatorNode* freeNode;
+        {
+            std::lock_guard<std::mutex> lock(allocator->mutex);
+            size_t count;
+            freeNode = PopFreeNodes(allocator, count);
+            PushFreeNodes(allocator, freeNode->next);
+        }
+
+        AddConcurrentStats(allocator, 1, 1);
+        return freeNode;
+    }
+
+    ConcurrentAllocatorCache& cache = GetThreadCache(allocator);
+    if (!cache.nodes)
+    {
+        std::lock_guard<std::mutex> lock(allocator->mutex);
+        cache.nodes = PopFreeNodes(allocator, cache.numNodes);
+    }
+
+    AllocatorNode* freeNode = cache.nodes;
+    cache.nodes = freeNode->next;
+    --cache.numNodes;
+
+    void* ptr = freeNode;
+
+    ++cache.pendingLive;
+    if (++cache.pendingAllocations >= CONCURRENT_STATS_INTERVAL)
+        PublishCacheStats(cache);
+
+    return ptr;
+}
+
+void ConcurrentAllocatorFree(ConcurrentAllocatorBlock* allocator, void* ptr)
+{
+    if (!allocator || !ptr)
+        return;
+
+    AllocatorNode* node = static_cast<AllocatorNode*>(ptr);
+    if (sThreadCachesDestroyed)
+    {
+        node->next = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(allocator->mutex);
+            PushFreeNodes(allocator, node);
+        }
+        AddConcurrentStats(allocator, -1, 0);
+        return;
+    }
+
+    ConcurrentAllocatorCache& cache = GetThreadCache(allocator);
+    node->next = cache.nodes;
+    cache.nodes = node;
+
+    if (--cache.pendingLive <= -CONCURRENT_STATS_INTERVAL)
+        PublishCacheStats(cache);
+
+    // Give a batch back so threads freeing nodes allocated elsewhere do not hoard them.
+    if (++cache.numNodes > CONCURRENT_CACHE_SIZE)
+    {
+        AllocatorNode* batch = cache.nodes;
+        AllocatorNode* last = batch;
+        for (size_t i = 1; i < CONCURRENT_BATCH_SIZE; ++i)
+            last = last->next;
+        cache.nodes = last->next;
+        cache.numNodes -= CONCURRENT_BATCH_SIZE;
+        last->next = nullptr;
+
+        std::lock_guard<std::mutex> lock(allocator->mutex);
+        allocator->batches.push_back(batch);
+    }
+}
+
+size_t ConcurrentAllocatorTrim(ConcurrentAllocatorBlock* allocator)
+{
+    if (!allocator)
+        return 0;
+
+    std::lock_guard<std::mutex> lock(allocator->mutex);
+
+    // Shared nodes and the calling thread's cache are not reachable by other threads while the mutex is held.
+    AllocatorNode* free = nullptr;
+    auto takeChain = [&free](AllocatorNode* chain) {
+        while (chain)
+        {
+            AllocatorNode* next = chain->next;
+            chain->next = free;
+            free = chain;
+            chain = next;
+        }
+    };
+    for (AllocatorNode* batch : allocator->batches)
+        takeChain(batch);
+    takeChain(allocator->partial);
+    allocator->batches.clear();
+    allocator->partial = nullptr;
+    allocator->numPartial = 0;
+    if (!sThreadCachesDestroyed)
+    {
+        ConcurrentAllocatorCache& cache = GetThreadCache(allocator);
+        takeChain(cache.nodes);
+        cache.nodes = nullptr;
+        cache.numNodes = 0;
+    }
+
+    // Keep the initial block, the last in the chain, so the allocator does not restart from a tiny block.
+    AllocatorBlock* keep = allocator->blocks;
+    while (keep && keep->next)
+        keep = keep->next;
+
+    size_t released = AllocatorTrimBlocks(allocator->blocks, keep, free, allocator->numBlocks);
+    allocator->capacity -= released;
+    PushFreeNodes(allocator, free);
+
+    return released;
+}
+
+/// Return statistics of all initialized allocators. Must hold the registry mutex.
+static std::vector<AllocatorStats> CollectAllocatorStats(AllocatorRegistry& registry)
+{
+    std::vector<AllocatorStats> ret;
+
+    for (AllocatorBlock* allocator : registry.allocators)
+    {
+        AllocatorStats stats;
+        stats.name = allocator->name;
+        stats.nodeSize = allocator->nodeSize;
+        stats.blocks = allocator->numBlocks;
+        stats.capacity = allocator->capacity;
+        stats.bytesReserved = BytesReserved(allocator->numBlocks, allocator->capacity, allocator->nodeSize, allocator->alignment);
+        stats.liveNodes = allocator->liveNodes;
+        stats.peakNodes = allocator->peakNodes;
+        stats.allocations = allocator->allocations;
+        ret.push_back(stats);
+    }
+
+    for (ConcurrentAllocatorBlock* allocator : registry.slots)
+    {
+        if (!allocator)
+            continue;
+
+        PublishThreadStats(allocator);
+
+        AllocatorStats stats;
+        stats.name = allocator->name;
+        stats.nodeSize = allocator->nodeSize;
+        {
+            std::lock_guard<std::mutex> blockLock(allocator->mutex);
+            stats.blocks = allocator->numBlocks;
+            stats.capacity = allocator->capacity;
+        }
+        stats.bytesReserved = BytesReserved(stats.blocks, stats.capacity, allocator->nodeSize, allocator->alignment);
+        // Other threads publish in batches, so the sum may be briefly negative.
+        int64_t liveNodes = allocator->liveNodes.load(std::memory_order_relaxed);
+        stats.liveNodes = liveNodes > 0 ? static_cast<size_t>(liveNodes) : 0;
+        stats.peakNodes = static_cast<size_t>(allocator->peakNodes.load(std::memory_order_relaxed));
+        stats.allocations = static_cast<uint64_t>(allocator->allocations.load(std::memory_order_relaxed));
+        ret.push_back(stats);
+    }
+
+    return ret;
+}
+
+std::vector<AllocatorStats> GetAllocatorStats()
+{
+    AllocatorRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return CollectAllocatorStats(registry);
+}
+
+void LogAllocatorStats()
+{
+    std::vector<AllocatorStats> allStats;
+    std::vector<double> rates;
+    {
+        // Snapshot and previous counts must come from the same allocators, one that registers in between would
+        // shift them.
+        AllocatorRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        allStats = CollectAllocatorStats(registry);
+
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - registry.lastReport).count();
+        registry.lastReport = now;
+
+        // Rates come from the allocation count at the previous report, stored in the allocators.
+        size_t index = 0;
+        auto updateRate = [&](uint64_t& reportedAllocations) {
+            uint64_t allocations = allStats[index++].allocations;
+            rates.push_back(seconds > 0.0 ? (allocations - reportedAllocations) / seconds : 0.0);
+            reportedAllocations = allocations;
+        };
+
+        for (AllocatorBlock* allocator : registry.allocators)
+            updateRate(allocator->reportedAllocations);
+        for (ConcurrentAllocatorBlock* allocator : registry.slots)
+        {
+            if (allocator)
+                updateRate(allocator->reportedAllocations);
+        }
+    }
+
+    // Logged without the registry lock, the logger may initialize allocators.
+    for (size_t i = 0; i < allStats.size(); ++i)
+    {
+        const AllocatorStats& stats = allStats[i];
+        PT_TAG_INFO("Allocator", stats.name ? stats.name : "Unnamed",
+            ": live ", stats.liveNodes, ", peak ", stats.peakNodes, ", capacity ", stats.capacity,
+            " in ", stats.blocks, " blocks, ", stats.bytesReserved, " bytes, ", rates[i], " allocs/s");
+    }
 }
 
 } // namespace Pt
\ No newline at end of file
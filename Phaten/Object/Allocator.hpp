@@ -1,7 +1,11 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <new>
+#include <vector>
 
 namespace Pt {
 
@@ -9,41 +13,140 @@ struct AllocatorBlock;
 struct AllocatorNode;
 
 #define DEFAULT_ALLOCATE_INITIAL_CAPACITY 16
+/// Alignment that keeps each node on its own cache lines
+#define CACHE_LINE_SIZE 64
 
-/// Header info, chained together
+/// Header info, chained together. Nodes follow the header without per-node headers
 struct AllocatorBlock
 {
     /// Size of allocated object
     size_t nodeSize;
-    /// Numbers of Nodes in this block
+    /// Alignment of nodes, power of two
+    size_t alignment;
+    /// Numbers of Nodes in this block, in the first block numbers of Nodes in all blocks
     size_t capacity;
+    /// Numbers of Nodes in this block
+    size_t blockCapacity;
     /// Ptr to first free node
     AllocatorNode* free;
     // Next allocator block
     AllocatorBlock* next;
+    /// Statistics below are only kept in the first block
+    /// Name shown in statistics and leak reports, may be null
+    const char* name;
+    /// Number of blocks in the chain
+    size_t numBlocks;
+    /// Nodes currently allocated
+    size_t liveNodes;
+    /// Most nodes allocated at once
+    size_t peakNodes;
+    /// Total allocations since initialize
+    uint64_t allocations;
+    /// Allocations at the previous LogAllocatorStats()
+    uint64_t reportedAllocations;
 };
 
-/// Just a wrapper of a pointer
+/// Link stored inside a free node
 struct AllocatorNode
 {
     AllocatorNode* next;
 };
 
-/// Initialize a fixed-size allocator
-AllocatorBlock* AllocatorInitialize(size_t nodeSize, size_t initialCapacity = DEFAULT_ALLOCATE_INITIAL_CAPACITY);
-/// Free all blocks in the chain
+/// Initialize a fixed-size allocator. The name must outlive the allocator
+AllocatorBlock* AllocatorInitialize(size_t nodeSize, size_t initialCapacity = DEFAULT_ALLOCATE_INITIAL_CAPACITY, const char* name = nullptr,
+    size_t alignment = alignof(std::max_align_t));
+/// Free all blocks in the chain, reporting nodes still allocated
 void AllocatorUninitialize(AllocatorBlock* allocator);
 /// Allocate a node, will construct new blocks if it reaches the capacity
 void* AllocatorGet(AllocatorBlock* allocator);
 /// Free one node
 void AllocatorFree(AllocatorBlock* allocator, void* ptr);
+/// Free blocks with no allocated nodes except the first one. Return numbers of Nodes released
+size_t AllocatorTrim(AllocatorBlock* allocator);
+
+/// Header info of a thread-safe fixed-size allocator.
+/// Each thread allocates from and frees to its own cache. Caches move nodes to and from the shared free nodes in
+/// fixed-size batches under the mutex, so nodes freed on another thread are reused instead of growing the allocator.
+/// The shared free nodes are not a lock-free list. Handing out batches of a bounded size needs a count next to the
+/// chains, and the mutex belongs to this allocator and is taken about once per batch of allocations or frees.
+struct ConcurrentAllocatorBlock
+{
+    /// Size of allocated object
+    size_t nodeSize;
+    /// Alignment of nodes, power of two
+    size_t alignment;
+    /// Numbers of Nodes in all blocks
+    size_t capacity;
+    /// Unique id, thread caches with another id are stale
+    uint64_t id;
+    /// Index of the thread caches, reused after uninitialize
+    unsigned slot;
+    /// Shared free nodes in full batches, each a null-terminated chain. Guarded by mutex
+    std::vector<AllocatorNode*> batches;
+    /// Shared free nodes not filling a batch yet, guarded by mutex
+    AllocatorNode* partial;
+    size_t numPartial;
+    /// Chain of node blocks, guarded by mutex
+    AllocatorBlock* blocks;
+    /// Taken when moving batches, growing or trimming
+    std::mutex mutex;
+    /// Name shown in statistics and leak reports, may be null
+    const char* name;
+    /// Number of node blocks, guarded by mutex
+    size_t numBlocks;
+    /// Threads count in their cache and add in batches, so these lag behind while other threads allocate.
+    /// peakNodes is taken when counts are added, so it may miss up to 63 nodes per thread
+    std::atomic<int64_t> liveNodes;
+    std::atomic<int64_t> peakNodes;
+    std::atomic<int64_t> allocations;
+    /// Allocations at the previous LogAllocatorStats()
+    uint64_t reportedAllocations;
+};
+
+/// Initialize a thread-safe fixed-size allocator. The name must outlive the allocator
+ConcurrentAllocatorBlock* ConcurrentAllocatorInitialize(size_t nodeSize, size_t initialCapacity = DEFAULT_ALLOCATE_INITIAL_CAPACITY,
+    const char* name = nullptr, size_t alignment = alignof(std::max_align_t));
+/// Free all blocks, reporting nodes still allocated. No other thread may use the allocator anymore
+void ConcurrentAllocatorUninitialize(ConcurrentAllocatorBlock* allocator);
+/// Allocate a node from the calling thread's cache, will take a shared batch or construct a new block if empty
+void* ConcurrentAllocatorGet(ConcurrentAllocatorBlock* allocator);
+/// Free one node to the calling thread's cache. The node may have been allocated on another thread
+void ConcurrentAllocatorFree(ConcurrentAllocatorBlock* allocator, void* ptr);
+/// Free blocks whose nodes are all in the shared free nodes or the calling thread's cache, except the first one.
+/// Nodes cached by other threads keep their block alive. Return numbers of Nodes released
+size_t ConcurrentAllocatorTrim(ConcurrentAllocatorBlock* allocator);
+
+/// Snapshot of one allocator
+struct AllocatorStats
+{
+    const char* name;
+    size_t nodeSize;
+    size_t blocks;
+    /// Nodes in all blocks
+    size_t capacity;
+    /// Memory taken by blocks including headers
+    size_t bytesReserved;
+    size_t liveNodes;
+    size_t peakNodes;
+    uint64_t allocations;
+};
+
+/// Return statistics of all initialized allocators. Counts of concurrent allocators are approximate while other threads allocate,
+/// and their peak may be up to 63 nodes per thread too low
+std::vector<AllocatorStats> GetAllocatorStats();
+/// Log statistics of all initialized allocators, with allocation rate since the previous call
+void LogAllocatorStats();
 
 template <typename T>
 class Allocator
 {
 public:
-    Allocator(size_t capacity = DEFAULT_ALLOCATE_INITIAL_CAPACITY) :
-        allocator(nullptr)
+    /// The name is used in statistics and leak reports and must outlive the allocator.
+    /// Alignment may be raised, e.g. to CACHE_LINE_SIZE so objects used by different threads do not share cache lines.
+    Allocator(size_t capacity = DEFAULT_ALLOCATE_INITIAL_CAPACITY, const char* name = nullptr, size_t alignment = alignof(T)) :
+        allocator(nullptr),
+        name(name),
+        alignment(alignment)
     {
         if (capacity)
             Reserve(capacity);
@@ -58,13 +161,13 @@ public:
     void Reserve(size_t capacity)
     {
         if (!allocator)
-            allocator = AllocatorInitialize(sizeof(T), capacity);
+            allocator = AllocatorInitialize(sizeof(T), capacity, name, alignment);
     }
 
     T* Allocate()
     {
         if (!allocator)
-            AllocatorInitialize(sizeof(T));
+            allocator = AllocatorInitialize(sizeof(T), DEFAULT_ALLOCATE_INITIAL_CAPACITY, name, alignment);
         T* newObject = static_cast<T*>(AllocatorGet(allocator));
         new(newObject) T();
 
@@ -74,7 +177,7 @@ public:
     T* Allocate(const T& object)
     {
         if (!allocator)
-            AllocatorInitialize(sizeof(T));
+            allocator = AllocatorInitialize(sizeof(T), DEFAULT_ALLOCATE_INITIAL_CAPACITY, name, alignment);
         T* newObject = static_cast<T*>(AllocatorGet(allocator));
         new(newObject) T(object);
 
@@ -86,6 +189,11 @@ public:
         (object)->~T();
         AllocatorFree(allocator, object);
     }
+    /// Release blocks with no live objects, return numbers of objects released
+    size_t Trim()
+    {
+        return AllocatorTrim(allocator);
+    }
     void Reset()
     {
         AllocatorUninitialize(allocator);
@@ -96,6 +204,87 @@ private:
     Allocator<T>& operator = (const Allocator<T>& rhs);
 
     AllocatorBlock* allocator;
+    const char* name;
+    size_t alignment;
+};
+
+/// Thread-safe version of Allocator. Allocate, Free and Trim may be called from any thread, Reserve and Reset may not.
+template <typename T>
+class ConcurrentAllocator
+{
+public:
+    /// The name is used in statistics and leak reports and must outlive the allocator.
+    /// Alignment may be raised, e.g. to CACHE_LINE_SIZE so objects used by different threads do not share cache lines.
+    ConcurrentAllocator(size_t capacity = DEFAULT_ALLOCATE_INITIAL_CAPACITY, const char* name = nullptr, size_t alignment = alignof(T)) :
+        allocator(nullptr),
+        name(name),
+        alignment(alignment)
+    {
+        if (capacity)
+            Reserve(capacity);
+    }
+
+    ~ConcurrentAllocator()
+    {
+        Reset();
+    }
+
+    /// Reserve initial, only possible before allocating the first object
+    void Reserve(size_t capacity)
+    {
+        if (!allocator)
+            allocator = ConcurrentAllocatorInitialize(sizeof(T), capacity, name, alignment);
+    }
+
+    T* Allocate()
+    {
+        if (!allocator)
+            allocator = ConcurrentAllocatorInitialize(sizeof(T), DEFAULT_ALLOCATE_INITIAL_CAPACITY, name, alignment);
+        T* newObject = static_cast<T*>(ConcurrentAllocatorGet(allocator));
+        new(newObject) T();
+
+        return newObject;
+    }
+
+    T* Allocate(const T& object)
+    {
+        if (!allocator)
+            allocator = ConcurrentAllocatorInitialize(sizeof(T), DEFAULT_ALLOCATE_INITIAL_CAPACITY, name, alignment);
+        T* newObject = static_cast<T*>(ConcurrentAllocatorGet(allocator));
+        new(newObject) T(object);
+
+        return newObject;
+    }
+
+    void Free(T* object)
+    {
+        (object)->~T();
+        ConcurrentAllocatorFree(allocator, object);
+    }
+    /// Release blocks with no live objects, return numbers of objects released
+    size_t Trim()
+    {
+        return ConcurrentAllocatorTrim(allocator);
+    }
+    void Reset()
+    {
+        ConcurrentAllocatorUninitialize(allocator);
+        allocator = nullptr;
+    }
+private:
+    ConcurrentAllocator(const ConcurrentAllocator<T>& rhs);
+    ConcurrentAllocator<T>& operator = (const ConcurrentAllocator<T>& rhs);
+
+    ConcurrentAllocatorBlock* allocator;
+    const char* name;
+    size_t alignment;
 };
 
+/// Allocator used by object factories and reference counts.
+#ifdef PT_CONCURRENT_ALLOCATOR
+template <typename T> using ObjectAllocator = ConcurrentAllocator<T>;
+#else
+template <typename T> using ObjectAllocator = Allocator<T>;
+#endif
+
 }
\ No newline at end of file
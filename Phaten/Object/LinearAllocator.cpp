@@ -0,0 +1,107 @@
+#include "LinearAllocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace Pt {
+
+/// Round address up to a power of two alignment.
+static unsigned char* AlignPointer(unsigned char* ptr, size_t alignment)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    return reinterpret_cast<unsigned char*>((address + alignment - 1) & ~(uintptr_t)(alignment - 1));
+}
+
+LinearAllocator::LinearAllocator(size_t capacity) :
+    m_Buffer(nullptr),
+    m_Capacity(capacity),
+    m_Current(nullptr),
+    m_End(nullptr),
+    m_Overflow(nullptr),
+    m_OverflowSize(0),
+    m_Used(0),
+    m_PeakUsed(0)
+{
+    if (m_Capacity)
+        m_Buffer = new unsigned char[m_Capacity];
+    m_Current = m_Buffer;
+    m_End = m_Buffer + m_Capacity;
+}
+
+LinearAllocator::~LinearAllocator()
+{
+    Reset();
+    delete[] m_Buffer;
+}
+
+void* LinearAllocator::Allocate(size_t size, size_t alignment)
+{
+    assert(alignment && !(alignment & (alignment - 1))); // Alignment must be a power of two
+
+    unsigned char* ptr = AlignPointer(m_Current, alignment);
+    if (!m_Current || ptr + size > m_End)
+    {
+        Grow(size, alignment);
+        ptr = AlignPointer(m_Current, alignment);
+    }
+
+    m_Used += (ptr + size) - m_Current;
+    m_Current = ptr + size;
+    return ptr;
+}
+
+void LinearAllocator::Reset()
+{
+    m_PeakUsed = std::max(m_PeakUsed, m_Used);
+
+    if (m_Overflow)
+    {
+        while (m_Overflow)
+        {
+            Chunk* previous = m_Overflow->previous;
+            delete[] reinterpret_cast<unsigned char*>(m_Overflow);
+            m_Overflow = previous;
+        }
+
+        // Grow once so the same workload fits in the main buffer next time.
+        delete[] m_Buffer;
+        m_Capacity += m_OverflowSize;
+        m_Buffer = new unsigned char[m_Capacity];
+        m_OverflowSize = 0;
+    }
+
+    m_Current = m_Buffer;
+    m_End = m_Buffer + m_Capacity;
+    m_Used = 0;
+}
+
+void LinearAllocator::Grow(size_t size, size_t alignment)
+{
+    // Account the unused tail of the current chunk so Used() matches what the next frame needs.
+    m_Used += m_End - m_Current;
+
+    size_t chunkSize = std::max(m_Capacity, sizeof(Chunk) + size + alignment);
+    unsigned char* memory = new unsigned char[chunkSize];
+    Chunk* chunk = reinterpret_cast<Chunk*>(memory);
+    chunk->previous = m_Overflow;
+    m_Overflow = chunk;
+    m_OverflowSize += chunkSize;
+
+    m_Current = memory + sizeof(Chunk);
+    m_End = memory + chunkSize;
+}
+
+DoubleBufferedAllocator::DoubleBufferedAllocator(size_t capacity) :
+    m_Allocators{ LinearAllocator(capacity), LinearAllocator(capacity) },
+    m_Index(0)
+{
+}
+
+void DoubleBufferedAllocator::Swap()
+{
+    m_Index ^= 1;
+    m_Allocators[m_Index].Reset();
+}
+
+} // namespace Pt
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Pt {
+
+#define DEFAULT_LINEAR_ALLOCATOR_CAPACITY (64 * 1024)
+
+/// Bump allocator for transient data. Memory is released all at once by Reset(). Not thread-safe.
+class LinearAllocator
+{
+public:
+    LinearAllocator(size_t capacity = DEFAULT_LINEAR_ALLOCATOR_CAPACITY);
+    ~LinearAllocator();
+
+    LinearAllocator(const LinearAllocator&) = delete;
+    LinearAllocator& operator = (const LinearAllocator&) = delete;
+
+    /// Allocate memory valid until the next Reset(). Falls back to an overflow chunk when the buffer is full.
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    /// Allocate uninitialized storage for count objects.
+    template <typename T> T* Allocate(size_t count = 1) { return static_cast<T*>(Allocate(count * sizeof(T), alignof(T))); }
+    /// Release all allocations. If overflow chunks were needed, the buffer grows to fit them so later frames allocate nothing.
+    void Reset();
+
+    /// Return bytes allocated since the last reset, including overflow chunks.
+    size_t Used() const { return m_Used; }
+    /// Return size of the main buffer.
+    size_t Capacity() const { return m_Capacity; }
+    /// Return the most bytes used between two resets.
+    size_t PeakUsed() const { return m_PeakUsed; }
+private:
+    /// Header of an overflow chunk, chained to the previous one.
+    struct Chunk
+    {
+        Chunk* previous;
+    };
+
+    /// Allocate an overflow chunk large enough for size bytes at alignment and make it current.
+    void Grow(size_t size, size_t alignment);
+
+    unsigned char* m_Buffer;
+    size_t m_Capacity;
+    /// Bump pointer and end of the current buffer or overflow chunk.
+    unsigned char* m_Current;
+    unsigned char* m_End;
+    /// Most recent overflow chunk, null if none.
+    Chunk* m_Overflow;
+    /// Total size of overflow chunks.
+    size_t m_OverflowSize;
+    size_t m_Used;
+    size_t m_PeakUsed;
+};
+
+/// Two linear allocators used on alternate frames. Data allocated in one frame stays valid until the end of the next.
+class DoubleBufferedAllocator
+{
+public:
+    DoubleBufferedAllocator(size_t capacity = DEFAULT_LINEAR_ALLOCATOR_CAPACITY);
+
+    /// Allocate memory valid until the end of the next frame.
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) { return Current().Allocate(size, alignment); }
+    template <typename T> T* Allocate(size_t count = 1) { return Current().Allocate<T>(count); }
+    /// Switch to the other allocator and reset it, releasing data from two frames ago.
+    void Swap();
+
+    LinearAllocator& Current() { return m_Allocators[m_Index]; }
+private:
+    LinearAllocator m_Allocators[2];
+    unsigned m_Index;
+};
+
+/// STL allocator allocating from a LinearAllocator. Deallocation does nothing, memory is reclaimed by Reset().
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    ArenaAllocator(LinearAllocator& arena) noexcept :
+        m_Arena(&arena)
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept :
+        m_Arena(other.Arena())
+    {
+    }
+
+    T* allocate(size_t count) { return m_Arena->Allocate<T>(count); }
+    void deallocate(T*, size_t) noexcept {}
+
+    LinearAllocator* Arena() const { return m_Arena; }
+
+    template <typename U> bool operator == (const ArenaAllocator<U>& rhs) const { return m_Arena == rhs.Arena(); }
+    template <typename U> bool operator != (const ArenaAllocator<U>& rhs) const { return m_Arena != rhs.Arena(); }
+private:
+    LinearAllocator* m_Arena;
+};
+
+/// Containers living in a LinearAllocator. Must not outlive its Reset().
+template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+} // namespace Pt
\ No newline at end of file
@@ -1,27 +1,47 @@
 #include "Object.hpp"
 
+#include <atomic>
+
 namespace Pt {
 
 std::map<StringHash, Object*> Object::sSubSystems;
 std::map<StringHash, ScopedPtr<ObjectFactory>> Object::sFactories;
+std::vector<Object*> Object::sSubsystemSlots;
+std::vector<ObjectFactory*> Object::sFactorySlots;
+
+/// Store value at index, growing the vector with nulls.
+template <typename T>
+static void SetSlot(std::vector<T*>& slots, unsigned index, T* value)
+{
+    if (index >= slots.size())
+        slots.resize(index + 1, nullptr);
+    slots[index] = value;
+}
 
 void Object::ReleaseRef()
 {
-    assert(refCount && refCount->refs > 0);
-    --(refCount->refs);
-    if (refCount->refs == 0)
+    assert(Refs() > 0);
+    if (DecrementRefs() == 0)
     {
         Destory(this);
     }   
 }
 
+unsigned Object::AllocateTypeIndex()
+{
+    static std::atomic<unsigned> nextIndex(0);
+    return nextIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
 void Object::RegisterSubsystem(Object* subsystem)
 {
     if (!subsystem)
     {
         return;
     }
+    StringHash::Register(subsystem->TypeName());
     sSubSystems[subsystem->Type()] = subsystem;
+    SetSlot(sSubsystemSlots, subsystem->TypeIndex(), subsystem);
 }
 
 Object* Object::Subsystem(StringHash type)
@@ -41,12 +61,18 @@ void Object::RemoveSubsystem(Object* subsystem)
     if (it != sSubSystems.end() && it->second == subsystem)
     {
         sSubSystems.erase(it);
+        sSubsystemSlots[subsystem->TypeIndex()] = nullptr;
     }
 }
 
 void Object::RemoveSubsystem(StringHash type)
 {
-    sSubSystems.erase(type);
+    auto it = sSubSystems.find(type);
+    if (it != sSubSystems.end())
+    {
+        sSubsystemSlots[it->second->TypeIndex()] = nullptr;
+        sSubSystems.erase(it);
+    }
 }
 
 void Object::RegisterFactory(ObjectFactory* factory)
@@ -55,13 +81,20 @@ void Object::RegisterFactory(ObjectFactory* factory)
     {
         return;
     }
+    StringHash::Register(factory->TypeName());
     sFactories[factory->Type()] = factory;
+    SetSlot(sFactorySlots, factory->TypeIndex(), factory);
 }
 
 Object* Object::FactoryCreate(StringHash type)
 {
     auto it = sFactories.find(type);
-    return it != sFactories.end() ? sFactories[type]->Create() : nullptr;
+    return it != sFactories.end() ? it->second->Create() : nullptr;
+}
+
+Object* Object::FactoryCreate(ObjectFactory* factory)
+{
+    return factory->Create();
 }
 
 void Object::Destory(Object* object)
@@ -71,10 +104,11 @@ void Object::Destory(Object* object)
         return;
     }
 
-    auto it = sFactories.find(object->Type());
-    if (it != sFactories.end())
+    unsigned index = object->TypeIndex();
+    ObjectFactory* factory = index < sFactorySlots.size() ? sFactorySlots[index] : nullptr;
+    if (factory)
     {
-        it->second->Destroy(object);
+        factory->Destroy(object);
     }
     else {
         delete object;
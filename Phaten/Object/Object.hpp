@@ -3,6 +3,7 @@
 #include <map>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "Object/Allocator.hpp"
 #include "Ptr.hpp"
@@ -18,6 +19,8 @@ class ObjectFactoryImpl;
 class Object : RefCounted
 {
 public: 
+    /// Construct. Types shared between threads pass RefCountPolicy::THREAD_SAFE.
+    Object(RefCountPolicy policy = RefCountPolicy::SINGLE_THREAD) : RefCounted(policy) {}
     virtual ~Object() = default;
 
     virtual void ReleaseRef() override;
@@ -26,13 +29,19 @@ public:
     virtual StringHash Type() const = 0;
     /// Get type name.
     virtual std::string_view TypeName() const = 0;
+    /// Get dense index of the type, assigned on first use. Only valid within one run.
+    virtual unsigned TypeIndex() const = 0;
+
+    /// Assign the next dense type index.
+    static unsigned AllocateTypeIndex();
 
     /// Register an object which can accessed globally.
     static void RegisterSubsystem(Object* subsystem);
-    /// Register subsystem by object type.
+    /// Get subsystem by object type.
     template <typename T> static T* Subsystem()
     { 
-        return static_cast<T*>(Subsystem(T::TypeStatic()));
+        unsigned index = T::TypeIndexStatic();
+        return index < sSubsystemSlots.size() ? static_cast<T*>(sSubsystemSlots[index]) : nullptr;
     }
     /// Remove subsystem by pointer.
     static void RemoveSubsystem(Object* subsystem);
@@ -49,7 +58,9 @@ public:
     template <typename T, typename = std::enable_if_t<std::is_base_of_v<Object, T>>>
     static T* FactoryCreate()
     {
-        return static_cast<T*>(FactoryCreate(T::TypeStatic()));
+        unsigned index = T::TypeIndexStatic();
+        ObjectFactory* factory = index < sFactorySlots.size() ? sFactorySlots[index] : nullptr;
+        return static_cast<T*>(factory ? FactoryCreate(factory) : nullptr);
     }
 
     /// Destroy an object through a factory if exists. If not, just delete.
@@ -63,11 +74,16 @@ private:
     static void RegisterFactory(ObjectFactory* factory);
     /// Create an object using factory.
     static Object* FactoryCreate(StringHash type);
+    static Object* FactoryCreate(ObjectFactory* factory);
 
     /// Registerd subsystem objects.
     static std::map<StringHash, Object*> sSubSystems;
     /// Registerd ObjectFactories.
     static std::map<StringHash, ScopedPtr<ObjectFactory>> sFactories;
+    /// Subsystems by type index, null if not registered.
+    static std::vector<Object*> sSubsystemSlots;
+    /// Factories by type index, owned by sFactories.
+    static std::vector<ObjectFactory*> sFactorySlots;
 };
 
 /// Base class for object factory.
@@ -81,9 +97,12 @@ public:
 
     StringHash Type() const { return m_Type; }
     std::string_view TypeName() const { return m_Name; }
+    unsigned TypeIndex() const { return m_TypeIndex; }
 protected:
     /// Object type.
     StringHash m_Type;
+    /// Dense index of object type.
+    unsigned m_TypeIndex;
     /// Object name.
     std::string m_Name;
 };
@@ -94,19 +113,20 @@ class ObjectFactoryImpl : public ObjectFactory
 {
 public:
     ObjectFactoryImpl(size_t capacity = DEFAULT_ALLOCATE_INITIAL_CAPACITY) :
-        m_Allocator(capacity)
+        m_Allocator(capacity, T::TypeNameStatic().data())
     {
         m_Type = T::TypeStatic();
         m_Name = T::TypeNameStatic();
+        m_TypeIndex = T::TypeIndexStatic();
     }
 
     virtual Object* Create() override { return m_Allocator.Allocate(); }
     virtual void Destroy(Object* object) override { m_Allocator.Free(static_cast<T*>(object)); }
 private:
-    Allocator<T> m_Allocator;
+    ObjectAllocator<T> m_Allocator;
 };
 
-/// Add Type and TypeName for Object subclass.
+/// Add Type, TypeName and TypeIndex for Object subclass.
 #define OBJECT(typeName) \
 private: \
     static const StringHash sType; \
@@ -114,7 +134,9 @@ private: \
 public: \
     virtual StringHash Type() const override { return TypeStatic(); } \
     virtual std::string_view TypeName() const override { return TypeNameStatic(); } \
-    static StringHash TypeStatic() { static const StringHash type(#typeName); return type; } \
+    virtual unsigned TypeIndex() const override { return TypeIndexStatic(); } \
+    static constexpr StringHash TypeStatic() { constexpr StringHash type(#typeName); return type; } \
     static std::string_view TypeNameStatic() { static std::string_view type(#typeName); return type; } \
+    static unsigned TypeIndexStatic() { static const unsigned index = Object::AllocateTypeIndex(); return index; } \
 
 } // namespace Pt
\ No newline at end of file
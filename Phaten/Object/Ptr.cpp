@@ -6,38 +6,37 @@
 
 namespace Pt {
 
-static Allocator<RefCount> refCountAllocator;
+static ObjectAllocator<RefCount> refCountAllocator(DEFAULT_ALLOCATE_INITIAL_CAPACITY, "RefCount");
 
-RefCounted::RefCounted()
-: refCount(nullptr)
+RefCounted::RefCounted(RefCountPolicy policy)
+: refs(0),
+  threadSafe(policy == RefCountPolicy::THREAD_SAFE),
+  refCount(nullptr)
 {
+    // Allocating on first use could race when the first references are taken on different threads.
+    if (threadSafe)
+    {
+        refCount = refCountAllocator.Allocate();
+        refCount->threadSafe = true;
+    }
 }
 
 RefCounted::~RefCounted()
 {
     if (refCount)
     {
-        assert(refCount->refs == 0);
-        if (refCount->weakRefs == 0)
+        assert(Refs() == 0);
+        refCount->expired.store(true, std::memory_order_release);
+        // Release the weak reference held by the object. If WeakPtrs remain, the last one frees the structure.
+        if (refCount->Decrement(refCount->weakRefs) == 0)
             refCountAllocator.Free(refCount);
-        else
-            refCount->expired = true;
     }
 }
 
-void RefCounted::AddRef()
-{
-    if (!refCount)
-        refCount = refCountAllocator.Allocate();
-
-    ++(refCount->refs);
-}
-
 void RefCounted::ReleaseRef()
 {
-    assert(refCount && refCount->refs > 0);
-    --(refCount->refs);
-    if (refCount->refs == 0)
+    assert(Refs() > 0);
+    if (DecrementRefs() == 0)
         delete this;    
 }
 
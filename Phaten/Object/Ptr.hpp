@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <utility>
 #include <type_traits>
@@ -9,8 +10,9 @@ namespace Pt {
 
 /*
 For intrusive reference counting, the object must be based on RefCounted.
-The RefCounted class holds a structure (RefCount) to record the reference 
-count numbers.
+The RefCounted class counts strong references inline, so copying a
+SharedPtr touches only the object. A structure (RefCount) to record the
+weak reference count is allocated when the first WeakPtr is taken.
 
 Basic rules:
 A SharedPtr will contribute to a strong reference count.
@@ -30,23 +32,85 @@ its expired flag as true. So a WeakPtr may still exist while its pointed
 object is gone. Therefore, WeakPtr holds a refCount pointer to keep track of
 the object status. When the last WeakPtr is gone, its destructor will be
 responsible for the deallocation of the reference counting structure.
+
+The object itself holds one weak reference until it is destroyed. Whoever
+drops the weak count to zero frees the structure, so the object and the
+last WeakPtr never race on who frees it.
+
+By default counts are only safe to modify from one thread at a time. Types
+constructed with RefCountPolicy::THREAD_SAFE use atomic read-modify-write
+operations instead, so SharedPtr and WeakPtr to them may be copied and
+released on any thread. Their strong count lives in the RefCount, which
+is allocated up front, so WeakPtr can check it after the object is gone. Use WeakPtr::Lock() to get a strong reference
+from a weak one on another thread.
 */
 
+/// How reference counts of an object are updated.
+enum class RefCountPolicy
+{
+    /// Plain increments. References must not be shared across threads.
+    SINGLE_THREAD,
+    /// Atomic increments, references may be added and released on any thread.
+    THREAD_SAFE,
+};
+
 /// Structure for reference counting
 struct RefCount
 {
     RefCount() :
         refs(0),
-        weakRefs(0),
-        expired(false)
+        weakRefs(1),
+        expired(false),
+        threadSafe(false)
     {}
 
-    /// Number of strong reference.
-    unsigned refs;
-    /// Number of weak reference.
-    unsigned weakRefs;
+    /// Add a reference to one of the counts.
+    void Increment(std::atomic<unsigned>& count)
+    {
+        if (threadSafe)
+            count.fetch_add(1, std::memory_order_relaxed);
+        else
+            count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /// Release a reference from one of the counts and return the remaining number.
+    unsigned Decrement(std::atomic<unsigned>& count)
+    {
+        if (threadSafe)
+            return count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+
+        unsigned remaining = count.load(std::memory_order_relaxed) - 1;
+        count.store(remaining, std::memory_order_relaxed);
+        return remaining;
+    }
+
+    /// Add a strong reference unless the last one is already gone.
+    bool TryAddRef()
+    {
+        unsigned current = refs.load(std::memory_order_relaxed);
+        do
+        {
+            if (!current)
+                return false;
+        } while (!refs.compare_exchange_weak(current, current + 1, std::memory_order_relaxed));
+
+        return true;
+    }
+
+    /// Return number of strong reference.
+    unsigned Refs() const { return refs.load(std::memory_order_relaxed); }
+    /// Return number of weak reference, excluding the one held by the object.
+    unsigned WeakRefs() const { return weakRefs.load(std::memory_order_relaxed) - (IsExpired() ? 0 : 1); }
+    bool IsExpired() const { return expired.load(std::memory_order_acquire); }
+
+    /// Number of strong reference. Only used by thread-safe objects and arrays, other objects count inline.
+    std::atomic<unsigned> refs;
+    /// Number of weak reference, plus one held by the object until it is destroyed.
+    std::atomic<unsigned> weakRefs;
     /// A flag. The object is no longer safe afetr this is set to true.
-    bool expired;
+    std::atomic<bool> expired;
+    /// Use atomic read-modify-write operations on the counts.
+    bool threadSafe;
 };
 
 /// Base class for reference counting.
@@ -54,22 +118,28 @@ class RefCounted
 {
     friend class Object;
 public:
-    /// Construct. RefCount is not allocated now but when needed.
-    RefCounted();
+    /// Construct. RefCount is not allocated now but when needed, unless the counts are thread-safe.
+    RefCounted(RefCountPolicy policy = RefCountPolicy::SINGLE_THREAD);
     /// Destruct. Free RefCount if no weak references, else marks it expired.
     ~RefCounted();
 
-    /// Add a strong reference (Allocate RefCount first time if neccessary).
-    void AddRef();
+    /// Add a strong reference.
+    void AddRef()
+    {
+        if (threadSafe)
+            refCount->Increment(refCount->refs);
+        else
+            ++refs;
+    }
     /// Release a strong reference. Destory the object when last strong reference is gone.
     /// Only provide function to release strong reference.
     /// WeakPtr does the weak reference release job 
     virtual void ReleaseRef();
 
     /// Get strong reference count.
-    unsigned Refs() const { return refCount ? refCount->refs : 0; }
+    unsigned Refs() const { return threadSafe ? refCount->Refs() : refs; }
     /// Get weak reference count.
-    unsigned WeakRefs() const { return refCount ? refCount->weakRefs : 0; }
+    unsigned WeakRefs() const { return refCount ? refCount->WeakRefs() : 0; }
     /// Get reference counting structure.
     RefCount* RefCountPtr();
 
@@ -82,6 +152,13 @@ private:
     RefCounted(const RefCounted& rhs);
     /// Prevent assignment
     RefCounted& operator = (const RefCounted& rhs);
+    /// Release a strong reference and return the remaining number.
+    unsigned DecrementRefs() { return threadSafe ? refCount->Decrement(refCount->refs) : --refs; }
+
+    /// Strong reference count, unless the counts are thread-safe.
+    unsigned refs;
+    /// Count strong references atomically in the RefCount structure.
+    bool threadSafe;
     /// Reference counting structure, allocated on demand.
     RefCount* refCount;
 };
@@ -173,9 +250,9 @@ public:
     /// Return object pointer
     T* Get() const { return ptr; }
     /// Return strong reference count
-    unsigned Refs() const { return ptr ?  ptr->Refs() : 0; }
+    unsigned Refs() const { return ptr ?  reinterpret_cast<RefCounted*>(ptr)->Refs() : 0; }
     /// Return weak reference count
-    unsigned WeakRefs() const { return ptr ? ptr->WeakRefs() : 0; }
+    unsigned WeakRefs() const { return ptr ? reinterpret_cast<RefCounted*>(ptr)->WeakRefs() : 0; }
     /// Return if it is a nullptr
     bool IsNull() const { return ptr == nullptr; }
 private:
@@ -256,9 +333,9 @@ public:
 
         Reset();
         ptr = rhs; // Just copy the object poiner.
-        refCount = ptr ? ptr->RefCountPtr() : nullptr; // copy RefCount if not nullptr
+        refCount = ptr ? reinterpret_cast<RefCounted*>(ptr)->RefCountPtr() : nullptr; // copy RefCount if not nullptr
         if (refCount)
-            ++(refCount->weakRefs); // Add weak reference if not nullptr
+            refCount->Increment(refCount->weakRefs); // Add weak reference if not nullptr
         return *this;
     }
 
@@ -272,7 +349,7 @@ public:
         ptr = rhs.ptr; // Just copy pointer as above
         refCount = rhs.refCount;
         if (refCount)
-            ++(refCount->weakRefs);
+            refCount->Increment(refCount->weakRefs);
         return *this;
     }
 
@@ -283,9 +360,9 @@ public:
 
         Reset();
         ptr = rhs.Get(); // Just get and copy pointer as above.
-        refCount = ptr ? ptr->RefCountPtr() : nullptr;
+        refCount = ptr ? reinterpret_cast<RefCounted*>(ptr)->RefCountPtr() : nullptr;
         if (refCount)
-            ++(refCount->weakRefs);
+            refCount->Increment(refCount->weakRefs);
         return *this;
     }
 
@@ -296,13 +373,27 @@ public:
     {
         if (refCount)
         {
-            --(refCount->weakRefs);
-            if (refCount->expired && refCount->weakRefs == 0)
+            // Reaching zero means the object has released its own weak reference as well.
+            if (refCount->Decrement(refCount->weakRefs) == 0)
                 RefCounted::FreeRefCount(refCount);
             ptr = nullptr;
             refCount = nullptr;
         }
     }
+
+    /// Return a strong reference, or null if the object is gone. Safe against the object being released on another thread.
+    SharedPtr<T> Lock() const
+    {
+        if (!refCount || !refCount->threadSafe)
+            return SharedPtr<T>(Get());
+        if (!refCount->TryAddRef())
+            return SharedPtr<T>();
+
+        // The temporary reference keeps the object alive until the SharedPtr holds its own.
+        SharedPtr<T> ret(ptr);
+        refCount->Decrement(refCount->refs);
+        return ret;
+    }
     
     template <typename U>
     void StaticCast(const WeakPtr<U>& rhs)
@@ -334,20 +425,20 @@ public:
     T* Get() const 
     {
         // Pointed Object may have been deconstructed.
-        if (refCount && !refCount->expired)
+        if (refCount && !refCount->IsExpired())
             return ptr;
         else
             return nullptr;
     }
 
     /// Return strong reference count
-    unsigned Refs() const { return ptr ?  ptr->Refs() : 0; }
+    unsigned Refs() const { return Get() ? reinterpret_cast<RefCounted*>(ptr)->Refs() : 0; }
     /// Return weak reference count
-    unsigned WeakRefs() const { return ptr ? ptr->WeakRefs() : 0; }
+    unsigned WeakRefs() const { return refCount ? refCount->WeakRefs() : 0; }
     /// Return if it is a nullptr
     bool IsNull() const { return ptr == nullptr; }
     /// Return whether the pointed object has been destroyed.
-    bool IsExpired() const { return refCount && refCount->expired; }
+    bool IsExpired() const { return refCount && refCount->IsExpired(); }
 private:
     /// Object pointer.
     T* ptr;
@@ -415,7 +506,7 @@ public:
             ptr = rhs;
             refCount = RefCounted::AllocateRefCount(); // Allocate reference counting structure here.
             if (refCount)
-                ++(refCount->refs);
+                refCount->Increment(refCount->refs);
         }
 
         return *this;
@@ -431,7 +522,7 @@ public:
         ptr = rhs.ptr;
         refCount = rhs.refCount;
         if (refCount)
-            ++(refCount->refs);
+            refCount->Increment(refCount->refs);
         
         return *this;
     }
@@ -446,12 +537,11 @@ public:
     {
         if (refCount)
         {   
-            --(refCount->refs);
-            if (refCount->refs == 0) // Because T is not based on RefCounted, we need to handle the deconstruct manually.
+            if (refCount->Decrement(refCount->refs) == 0) // Because T is not based on RefCounted, we need to handle the deconstruct manually.
             {
-                refCount->expired = true; // Mark expired, may still have WeakPtr references.
+                refCount->expired.store(true, std::memory_order_release); // Mark expired, may still have WeakPtr references.
                 delete[] ptr;
-                if (refCount->weakRefs == 0) // When no WeakPtr reference, free the reference counting structure.
+                if (refCount->Decrement(refCount->weakRefs) == 0) // When no WeakPtr reference, free the reference counting structure.
                     RefCounted::FreeRefCount(refCount);
             }
         }
@@ -467,7 +557,7 @@ public:
         ptr = static_cast<T*>(rhs.Get());
         refCount = rhs.RefCountPtr();
         if (refCount)
-            ++(refCount->refs);
+            refCount->Increment(refCount->refs);
     }
 
     template <typename U>
@@ -477,15 +567,15 @@ public:
         ptr = dynamic_cast<T*>(rhs.Get());
         refCount = rhs.RefCountPtr();
         if (refCount)
-            ++(refCount->refs);
+            refCount->Increment(refCount->refs);
     }
 
     /// Return raw pointer.
     T* Get() const { return ptr; }
     /// Return numbers of strong reference counting.
-    unsigned Refs() const { return refCount ? refCount->refs : 0; }
+    unsigned Refs() const { return refCount ? refCount->Refs() : 0; }
     /// Return numbers of weak reference counting.
-    unsigned WeakRefs() const { return refCount ? refCount->weakRefs : 0; }
+    unsigned WeakRefs() const { return refCount ? refCount->WeakRefs() : 0; }
     /// Return reference counting structure pointer.
     RefCount* RefCountPtr() const { return refCount; } 
     /// Return if ptr is null.
@@ -553,7 +643,7 @@ public:
         ptr = rhs.ptr;
         refCount = rhs.refCount;
         if (refCount)
-            ++(refCount->weakRefs);
+            refCount->Increment(refCount->weakRefs);
 
         return *this;
     }
@@ -567,7 +657,7 @@ public:
         ptr = rhs.Get();
         refCount = rhs.RefCountPtr();
         if (refCount)
-            ++(refCount->weakRefs);
+            refCount->Increment(refCount->weakRefs);
 
         return *this;
     }
@@ -610,10 +700,9 @@ public:
     {
         if (refCount)
         {
-            --(refCount->weakRefs);
-            // expired flag set to true means all strong reference have gone,
-            // so last WeakPtr is responsible for deallocating the RefCount.
-            if (refCount->expired && refCount->weakRefs == 0)
+            // The array holds a weak reference until all strong references have gone,
+            // so reaching zero means the last WeakPtr is responsible for deallocating the RefCount.
+            if (refCount->Decrement(refCount->weakRefs) == 0)
                 RefCounted::FreeRefCount(refCount);
         }
 
@@ -628,7 +717,7 @@ public:
         ptr = static_cast<T*>(rhs.Get());
         refCount = rhs.refCount;
         if (refCount)
-            ++(refCount->weakRefs);
+            refCount->Increment(refCount->weakRefs);
     }
 
     template <typename U>
@@ -638,25 +727,25 @@ public:
         ptr = reinterpret_cast<T*>(rhs);
         refCount = rhs.refCount;
         if (refCount)
-            ++(refCount->weakRefs);
+            refCount->Increment(refCount->weakRefs);
     }
 
     /// Return raw pointer.
     T* Get() const
     {
-        if (!refCount || refCount->expired)
+        if (!refCount || refCount->IsExpired())
             return nullptr;
         else
             return ptr;
     }
     /// Return numbers of strong reference counting.
-    unsigned Refs() const { return (refCount && refCount->refs >= 0) ? refCount->refs : 0; }
+    unsigned Refs() const { return refCount ? refCount->Refs() : 0; }
     /// Return numbers of weak reference counting.
-    unsigned WeakRefs() const { return refCount ? refCount->weakRefs : 0; }
+    unsigned WeakRefs() const { return refCount ? refCount->WeakRefs() : 0; }
     /// Return if ptr is null.
     bool IsNull() const { return ptr == nullptr; }
     /// Return whether the array has been destroyed.
-    bool IsExpired() const { return refCount ? refCount->expired : false; }
+    bool IsExpired() const { return refCount ? refCount->IsExpired() : false; }
 private:
     template <typename U> WeakArrayPtr(const WeakArrayPtr<U>& rhs);
     /// Pointer to array
@@ -739,7 +828,7 @@ public:
     }
 
     T* operator -> () const { assert(ptr); return ptr; }
-    T& operator *  () const { assert(ptr); return *this; }
+    T& operator *  () const { assert(ptr); return *ptr; }
     operator T* () const { return ptr; }
 
     T* Get() const { return ptr; }
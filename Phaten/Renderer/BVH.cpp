@@ -0,0 +1,494 @@
+#include "BVH.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "IO/Assert.hpp"
+#include "Thread/JobSystem.hpp"
+
+namespace Pt {
+
+static const unsigned NUM_BINS = 16;
+static const unsigned MAX_LEAF_SIZE = 8;
+/// Deeper nodes split at the object median so the tree depth stays bounded.
+static const unsigned MAX_SAH_DEPTH = 40;
+/// Cost of visiting a node relative to one triangle test.
+static const float TRAVERSAL_COST = 1.0f;
+/// Subtrees with at least this many triangles are built as separate jobs.
+static const unsigned PARALLEL_BUILD_THRESHOLD = 4096;
+static const unsigned STACK_SIZE = 96;
+
+/// Temporary node used during build.
+struct BVHBuildNode
+{
+    BoundingBox bounds;
+    BVHBuildNode* children[2];
+    unsigned first;
+    unsigned count;
+    unsigned axis;
+};
+
+/// Shared state of one build.
+struct BVHBuildContext
+{
+    const BoundingBox* triangleBounds;
+    const Vector3* centroids;
+    unsigned* indices;
+    std::atomic<unsigned> numNodes;
+    /// Null builds on the calling thread only.
+    JobSystem* jobSystem;
+};
+
+struct BVHBin
+{
+    BoundingBox bounds;
+    unsigned count = 0;
+};
+
+static BVHBuildNode* BuildRecursive(BVHBuildContext& context, unsigned first, unsigned count, unsigned depth)
+{
+    BVHBuildNode* node = new BVHBuildNode();
+    node->first = first;
+    node->count = count;
+    node->axis = 0;
+    node->children[0] = node->children[1] = nullptr;
+    ++context.numNodes;
+
+    unsigned* indices = context.indices + first;
+    BoundingBox centroidBounds;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        node->bounds.Merge(context.triangleBounds[indices[i]]);
+        centroidBounds.Merge(context.centroids[indices[i]]);
+    }
+
+    if (count <= 1)
+        return node;
+
+    // Evaluate SAH at bin boundaries of every axis.
+    Vector3 extent = centroidBounds.Size();
+    float bestCost = M_MAX_FLOAT;
+    int bestAxis = -1;
+    unsigned bestSplit = 0;
+
+    if (depth < MAX_SAH_DEPTH)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (extent[axis] <= 0.0f)
+                continue;
+
+            BVHBin bins[NUM_BINS];
+            float scale = NUM_BINS / extent[axis];
+            for (unsigned i = 0; i < count; ++i)
+            {
+                unsigned bin = std::min(static_cast<unsigned>((context.centroids[indices[i]][axis] - centroidBounds.min[axis]) * scale), NUM_BINS - 1);
+                ++bins[bin].count;
+                bins[bin].bounds.Merge(context.triangleBounds[indices[i]]);
+            }
+
+            float rightArea[NUM_BINS];
+            unsigned rightCount[NUM_BINS];
+            BoundingBox box;
+            unsigned boxCount = 0;
+            for (unsigned i = NUM_BINS - 1; i > 0; --i)
+            {
+                box.Merge(bins[i].bounds);
+                boxCount += bins[i].count;
+                rightArea[i] = box.SurfaceArea();
+                rightCount[i] = boxCount;
+            }
+
+            box.Clear();
+            boxCount = 0;
+            for (unsigned i = 0; i < NUM_BINS - 1; ++i)
+            {
+                box.Merge(bins[i].bounds);
+                boxCount += bins[i].count;
+                if (!boxCount || !rightCount[i + 1])
+                    continue;
+
+                float cost = boxCount * box.SurfaceArea() + rightCount[i + 1] * rightArea[i + 1];
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = i + 1;
+                }
+            }
+        }
+    }
+
+    float parentArea = node->bounds.SurfaceArea();
+    float splitCost = parentArea > 0.0f ? TRAVERSAL_COST + bestCost / parentArea : M_MAX_FLOAT;
+    if (count <= MAX_LEAF_SIZE && (bestAxis < 0 || splitCost >= count))
+        return node;
+
+    unsigned* middle = nullptr;
+    if (bestAxis >= 0)
+    {
+        float scale = NUM_BINS / extent[bestAxis];
+        float minimum = centroidBounds.min[bestAxis];
+        middle = std::partition(indices, indices + count, [&](unsigned index)
+        {
+            unsigned bin = std::min(static_cast<unsigned>((context.centroids[index][bestAxis] - minimum) * scale), NUM_BINS - 1);
+            return bin < bestSplit;
+        });
+        node->axis = bestAxis;
+    }
+
+    // Fall back to an object median split when SAH could not separate the triangles.
+    if (!middle || middle == indices || middle == indices + count)
+    {
+        unsigned axis = centroidBounds.LongestAxis();
+        middle = indices + count / 2;
+        std::nth_element(indices, middle, indices + count, [&](unsigned lhs, unsigned rhs)
+        {
+            return context.centroids[lhs][axis] < context.centroids[rhs][axis];
+        });
+        node->axis = axis;
+    }
+
+    unsigned leftCount = static_cast<unsigned>(middle - indices);
+    unsigned rightCount = count - leftCount;
+
+    if (count >= PARALLEL_BUILD_THRESHOLD && context.jobSystem)
+    {
+        TaskGroup group(context.jobSystem);
+        group.Run([&]()
+        {
+            node->children[0] = BuildRecursive(context, first, leftCount, depth + 1);
+        });
+        node->children[1] = BuildRecursive(context, first + leftCount, rightCount, depth + 1);
+        group.Wait();
+    }
+    else
+    {
+        node->children[0] = BuildRecursive(context, first, leftCount, depth + 1);
+        node->children[1] = BuildRecursive(context, first + leftCount, rightCount, depth + 1);
+    }
+
+    return node;
+}
+
+/// Append node and its subtree in depth first order and free the build nodes. Return node index.
+static unsigned Flatten(BVHBuildNode* buildNode, std::vector<BVHNode>& nodes)
+{
+    unsigned index = static_cast<unsigned>(nodes.size());
+    nodes.emplace_back();
+    nodes[index].min = buildNode->bounds.min;
+    nodes[index].max = buildNode->bounds.max;
+    nodes[index].axis = static_cast<uint16_t>(buildNode->axis);
+
+    if (!buildNode->children[0])
+    {
+        PT_ASSERT_MSG(buildNode->count <= UINT16_MAX, "BVH leaf too large: ", buildNode->count);
+        nodes[index].offset = buildNode->first;
+        nodes[index].count = static_cast<uint16_t>(buildNode->count);
+    }
+    else
+    {
+        Flatten(buildNode->children[0], nodes);
+        unsigned second = Flatten(buildNode->children[1], nodes);
+        nodes[index].offset = second;
+        nodes[index].count = 0;
+    }
+
+    delete buildNode;
+    return index;
+}
+
+/// Return true if ray hits node bounds nearer than max distance.
+static inline bool HitNode(const BVHNode& node, const Vector3& origin, const Vector3& invDirection, float maxDistance)
+{
+    float tx0 = (node.min.x - origin.x) * invDirection.x;
+    float tx1 = (node.max.x - origin.x) * invDirection.x;
+    float ty0 = (node.min.y - origin.y) * invDirection.y;
+    float ty1 = (node.max.y - origin.y) * invDirection.y;
+    float tz0 = (node.min.z - origin.z) * invDirection.z;
+    float tz1 = (node.max.z - origin.z) * invDirection.z;
+
+    float near = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+    float far = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), maxDistance));
+    return near <= far;
+}
+
+/// Inverse direction clamped away from infinity, which fast math does not handle.
+static inline Vector3 SafeInverse(const Vector3& direction)
+{
+    Vector3 result;
+    for (int i = 0; i < 3; ++i)
+        result[i] = 1.0f / (::Abs(direction[i]) > M_EPSILON ? direction[i] : (direction[i] < 0.0f ? -M_EPSILON : M_EPSILON));
+    return result;
+}
+
+/// Inverse directions clamped away from infinity.
+template <typename T>
+static inline T SafeInverse(const T& direction)
+{
+    T epsilon(M_EPSILON);
+    T clamped = T::Select(direction < T(0.0f), -epsilon, epsilon);
+    return T(1.0f) / T::Select(T::Abs(direction) > epsilon, direction, clamped);
+}
+
+/// Test all lanes of a packet against one triangle and keep closer hits.
+template <typename T>
+static inline void IntersectTriangle(RayPacket<T>& packet, const Vector3& v0, const Vector3& v1, const Vector3& v2, unsigned index)
+{
+    Vector3SoA<T> edge1(v1 - v0);
+    Vector3SoA<T> edge2(v2 - v0);
+    Vector3SoA<T> p = packet.direction.Cross(edge2);
+    T det = edge1.Dot(p);
+    T valid = T::Abs(det) >= T(M_EPSILON);
+    T invDet = T(1.0f) / T::Select(valid, det, T(1.0f));
+
+    Vector3SoA<T> t = packet.origin - Vector3SoA<T>(v0);
+    T u = t.Dot(p) * invDet;
+    Vector3SoA<T> q = t.Cross(edge1);
+    T v = packet.direction.Dot(q) * invDet;
+    T distance = edge2.Dot(q) * invDet;
+
+    T zero(0.0f);
+    T one(1.0f);
+    T mask = valid & (u >= zero) & (u <= one) & (v >= zero) & (u + v <= one) & (distance >= zero) & (distance < packet.distance);
+    int bits = mask.Mask();
+    if (!bits)
+        return;
+
+    packet.distance = T::Select(mask, distance, packet.distance);
+    for (unsigned i = 0; i < RayPacket<T>::SIZE; ++i)
+    {
+        if (bits & (1 << i))
+            packet.triangle[i] = index;
+    }
+}
+
+/// Traverse the tree with a whole packet, descending while any lane hits the node.
+template <typename T>
+static void IntersectPacket(const std::vector<BVHNode>& nodes, const std::vector<Vector3>& positions, const std::vector<unsigned>& triangleIndices, RayPacket<T>& packet)
+{
+    if (nodes.empty())
+        return;
+
+    Vector3SoA<T> invDirection(SafeInverse(packet.direction.x), SafeInverse(packet.direction.y), SafeInverse(packet.direction.z));
+    // Order children by the direction of most lanes.
+    bool negative[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const T& direction = axis == 0 ? packet.direction.x : (axis == 1 ? packet.direction.y : packet.direction.z);
+        int bits = (direction < T(0.0f)).Mask();
+        unsigned count = 0;
+        for (unsigned i = 0; i < RayPacket<T>::SIZE; ++i)
+            count += (bits >> i) & 1;
+        negative[axis] = count * 2 > RayPacket<T>::SIZE;
+    }
+
+    unsigned stack[STACK_SIZE];
+    unsigned stackSize = 0;
+    unsigned nodeIndex = 0;
+    T zero(0.0f);
+
+    for (;;)
+    {
+        const BVHNode& node = nodes[nodeIndex];
+        T tx0 = (T(node.min.x) - packet.origin.x) * invDirection.x;
+        T tx1 = (T(node.max.x) - packet.origin.x) * invDirection.x;
+        T ty0 = (T(node.min.y) - packet.origin.y) * invDirection.y;
+        T ty1 = (T(node.max.y) - packet.origin.y) * invDirection.y;
+        T tz0 = (T(node.min.z) - packet.origin.z) * invDirection.z;
+        T tz1 = (T(node.max.z) - packet.origin.z) * invDirection.z;
+        T near = T::Max(T::Max(T::Min(tx0, tx1), T::Min(ty0, ty1)), T::Max(T::Min(tz0, tz1), zero));
+        T far = T::Min(T::Min(T::Max(tx0, tx1), T::Max(ty0, ty1)), T::Min(T::Max(tz0, tz1), packet.distance));
+
+        if ((near <= far).Any())
+        {
+            if (!node.count)
+            {
+                if (negative[node.axis])
+                {
+                    stack[stackSize++] = nodeIndex + 1;
+                    nodeIndex = node.offset;
+                }
+                else
+                {
+                    stack[stackSize++] = node.offset;
+                    ++nodeIndex;
+                }
+                continue;
+            }
+
+            for (unsigned i = node.offset; i < node.offset + node.count; ++i)
+                IntersectTriangle(packet, positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2], i);
+        }
+
+        if (!stackSize)
+            break;
+        nodeIndex = stack[--stackSize];
+    }
+
+    for (unsigned i = 0; i < RayPacket<T>::SIZE; ++i)
+    {
+        if (packet.triangle[i] != UINT32_MAX)
+            packet.triangle[i] = triangleIndices[packet.triangle[i]];
+    }
+}
+
+BVH::BVH()
+{
+}
+
+void BVH::Build(const Vector3* positions, size_t numTriangles)
+{
+    Clear();
+    if (!positions || !numTriangles)
+        return;
+
+    std::vector<BoundingBox> triangleBounds(numTriangles);
+    std::vector<Vector3> centroids(numTriangles);
+    m_TriangleIndices.resize(numTriangles);
+    for (size_t i = 0; i < numTriangles; ++i)
+    {
+        BoundingBox& bounds = triangleBounds[i];
+        bounds.Merge(positions[i * 3]);
+        bounds.Merge(positions[i * 3 + 1]);
+        bounds.Merge(positions[i * 3 + 2]);
+        centroids[i] = bounds.Center();
+        m_TriangleIndices[i] = static_cast<unsigned>(i);
+    }
+
+    BVHBuildContext context;
+    context.triangleBounds = triangleBounds.data();
+    context.centroids = centroids.data();
+    context.indices = m_TriangleIndices.data();
+    context.numNodes = 0;
+    context.jobSystem = Object::Subsystem<JobSystem>();
+
+    BVHBuildNode* root = BuildRecursive(context, 0, static_cast<unsigned>(numTriangles), 0);
+    m_Nodes.reserve(context.numNodes);
+    Flatten(root, m_Nodes);
+
+    // Store triangles in leaf order so leaves read contiguous memory.
+    m_Positions.resize(numTriangles * 3);
+    for (size_t i = 0; i < numTriangles; ++i)
+    {
+        const Vector3* source = positions + m_TriangleIndices[i] * 3;
+        m_Positions[i * 3] = source[0];
+        m_Positions[i * 3 + 1] = source[1];
+        m_Positions[i * 3 + 2] = source[2];
+    }
+}
+
+void BVH::Clear()
+{
+    m_Nodes.clear();
+    m_Positions.clear();
+    m_TriangleIndices.clear();
+}
+
+bool BVH::Intersect(const Ray& ray, BVHHit& hit, float maxDistance) const
+{
+    if (m_Nodes.empty())
+        return false;
+
+    Vector3 invDirection = SafeInverse(ray.direction);
+    bool negative[3] = { ray.direction.x < 0.0f, ray.direction.y < 0.0f, ray.direction.z < 0.0f };
+
+    unsigned stack[STACK_SIZE];
+    unsigned stackSize = 0;
+    unsigned nodeIndex = 0;
+    unsigned closest = UINT32_MAX;
+    hit.distance = maxDistance;
+
+    for (;;)
+    {
+        const BVHNode& node = m_Nodes[nodeIndex];
+        if (HitNode(node, ray.origin, invDirection, hit.distance))
+        {
+            if (!node.count)
+            {
+                // Visit the child on the near side first.
+                if (negative[node.axis])
+                {
+                    stack[stackSize++] = nodeIndex + 1;
+                    nodeIndex = node.offset;
+                }
+                else
+                {
+                    stack[stackSize++] = node.offset;
+                    ++nodeIndex;
+                }
+                continue;
+            }
+
+            for (unsigned i = node.offset; i < node.offset + node.count; ++i)
+            {
+                float distance = ray.HitDistance(m_Positions[i * 3], m_Positions[i * 3 + 1], m_Positions[i * 3 + 2]);
+                if (distance < hit.distance)
+                {
+                    hit.distance = distance;
+                    closest = i;
+                }
+            }
+        }
+
+        if (!stackSize)
+            break;
+        nodeIndex = stack[--stackSize];
+    }
+
+    if (closest == UINT32_MAX)
+        return false;
+
+    hit.triangle = m_TriangleIndices[closest];
+    return true;
+}
+
+void BVH::Intersect(RayPacket4& packet) const
+{
+    IntersectPacket(m_Nodes, m_Positions, m_TriangleIndices, packet);
+}
+
+void BVH::Intersect(RayPacket8& packet) const
+{
+    IntersectPacket(m_Nodes, m_Positions, m_TriangleIndices, packet);
+}
+
+bool BVH::Occluded(const Ray& ray, float maxDistance) const
+{
+    if (m_Nodes.empty())
+        return false;
+
+    Vector3 invDirection = SafeInverse(ray.direction);
+
+    unsigned stack[STACK_SIZE];
+    unsigned stackSize = 0;
+    unsigned nodeIndex = 0;
+
+    for (;;)
+    {
+        const BVHNode& node = m_Nodes[nodeIndex];
+        if (HitNode(node, ray.origin, invDirection, maxDistance))
+        {
+            if (!node.count)
+            {
+                stack[stackSize++] = node.offset;
+                ++nodeIndex;
+                continue;
+            }
+
+            for (unsigned i = node.offset; i < node.offset + node.count; ++i)
+            {
+                if (ray.HitDistance(m_Positions[i * 3], m_Positions[i * 3 + 1], m_Positions[i * 3 + 2]) < maxDistance)
+                    return true;
+            }
+        }
+
+        if (!stackSize)
+            break;
+        nodeIndex = stack[--stackSize];
+    }
+
+    return false;
+}
+
+} // namespace Pt
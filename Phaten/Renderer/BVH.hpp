@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Math/BoundingBox.hpp"
+#include "Math/Ray.hpp"
+#include "Math/Vector.hpp"
+
+#include "RayPacket.hpp"
+
+namespace Pt {
+
+/// Flattened BVH node. The first child of an interior node directly follows it.
+struct BVHNode
+{
+    Vector3 min;
+    /// Interior: index of the second child. Leaf: first triangle.
+    unsigned offset;
+    Vector3 max;
+    /// Number of triangles, 0 for interior nodes.
+    uint16_t count;
+    /// Split axis of interior nodes.
+    uint16_t axis;
+};
+
+static_assert(sizeof(BVHNode) == 32, "BVHNode should fill half a cache line");
+
+/// Closest triangle found by a BVH query.
+struct BVHHit
+{
+    float distance;
+    /// Index of the triangle in the build input.
+    unsigned triangle;
+};
+
+/// Bounding volume hierarchy over triangles, built with binned SAH.
+class BVH
+{
+public:
+    BVH();
+
+    /// Build from triangle vertices, 3 per triangle. Large subtrees are built in parallel on the job system if it exists.
+    void Build(const Vector3* positions, size_t numTriangles);
+    /// Release nodes and triangles.
+    void Clear();
+
+    /// Find the closest hit within max distance.
+    bool Intersect(const Ray& ray, BVHHit& hit, float maxDistance = M_MAX_FLOAT) const;
+    /// Find the closest hits of a packet of rays.
+    void Intersect(RayPacket4& packet) const;
+    /// Find the closest hits of a packet of rays.
+    void Intersect(RayPacket8& packet) const;
+    /// Return true if anything is hit within max distance.
+    bool Occluded(const Ray& ray, float maxDistance = M_MAX_FLOAT) const;
+
+    /// Nodes in depth first order, root first.
+    const std::vector<BVHNode>& Nodes() const { return m_Nodes; }
+    /// Triangle vertices in leaf order, 3 per triangle.
+    const std::vector<Vector3>& Positions() const { return m_Positions; }
+    /// Build input index of each triangle in leaf order.
+    const std::vector<unsigned>& TriangleIndices() const { return m_TriangleIndices; }
+    /// Bounds of all triangles.
+    BoundingBox Bounds() const { return m_Nodes.empty() ? BoundingBox() : BoundingBox(m_Nodes[0].min, m_Nodes[0].max); }
+    bool IsEmpty() const { return m_Nodes.empty(); }
+private:
+    std::vector<BVHNode> m_Nodes;
+    std::vector<Vector3> m_Positions;
+    std::vector<unsigned> m_TriangleIndices;
+};
+
+} // namespace Pt
@@ -0,0 +1,134 @@
+#include "GeometryPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "IO/Logger.hpp"
+#include "Graphics/Graphics.hpp"
+
+namespace Pt {
+
+GeometryPool::GeometryPool(const VertexLayout& layout, size_t pageVertices, size_t pageIndices) :
+    m_Layout(layout),
+    m_PageVertices(pageVertices),
+    m_PageIndices(pageIndices)
+{
+}
+
+GeometryRange GeometryPool::Add(size_t numVertices, const void* vertices, size_t numIndices, const unsigned* indices)
+{
+    GeometryRange range{ 0, 0, 0, 0 };
+    if (!numVertices || !vertices || !numIndices || !indices)
+    {
+        PT_LOG_ERROR("Empty mesh can not be added to geometry pool");
+        return range;
+    }
+
+    size_t pageIdx = FindPage(numVertices, numIndices);
+    Page& page = m_Pages[pageIdx];
+    if (!page.vertexBuffer->SetData(page.usedVertices, numVertices, vertices) ||
+        !page.indexBuffer->SetData(page.usedIndices, numIndices, indices))
+    {
+        return range;
+    }
+
+    range.page = static_cast<unsigned>(pageIdx);
+    range.firstIndex = static_cast<unsigned>(page.usedIndices);
+    range.numIndices = static_cast<unsigned>(numIndices);
+    range.baseVertex = static_cast<int>(page.usedVertices);
+
+    page.usedVertices += numVertices;
+    page.usedIndices += numIndices;
+    return range;
+}
+
+void GeometryPool::Draw(const SharedPtr<ShaderProgram>& program, const GeometryRange& range)
+{
+    if (!range.IsValid() || range.page >= m_Pages.size())
+    {
+        return;
+    }
+
+    BindPage(program, m_Pages[range.page]);
+    Graphics::DrawIndexedBaseVertex(PrimitiveType::TRIANGLES, range.firstIndex, range.numIndices, range.baseVertex);
+}
+
+void GeometryPool::Queue(const GeometryRange& range)
+{
+    if (!range.IsValid() || range.page >= m_Pages.size())
+    {
+        return;
+    }
+
+    Page& page = m_Pages[range.page];
+    page.counts.push_back(static_cast<int>(range.numIndices));
+    page.firsts.push_back(range.firstIndex);
+    page.baseVertices.push_back(range.baseVertex);
+}
+
+void GeometryPool::Flush(const SharedPtr<ShaderProgram>& program)
+{
+    for (Page& page : m_Pages)
+    {
+        if (page.counts.empty())
+        {
+            continue;
+        }
+
+        BindPage(program, page);
+        if (page.counts.size() == 1)
+        {
+            Graphics::DrawIndexedBaseVertex(PrimitiveType::TRIANGLES, page.firsts[0], page.counts[0], page.baseVertices[0]);
+        }
+        else
+        {
+            Graphics::MultiDrawIndexedBaseVertex(PrimitiveType::TRIANGLES, page.counts.data(), page.firsts.data(),
+                page.baseVertices.data(), page.counts.size());
+        }
+
+        // Keep capacity, the same meshes are usually queued next frame.
+        page.counts.clear();
+        page.firsts.clear();
+        page.baseVertices.clear();
+    }
+}
+
+void GeometryPool::Clear()
+{
+    m_Pages.clear();
+}
+
+size_t GeometryPool::FindPage(size_t numVertices, size_t numIndices)
+{
+    for (size_t i = 0; i < m_Pages.size(); ++i)
+    {
+        const Page& page = m_Pages[i];
+        if (page.usedVertices + numVertices <= page.vertexBuffer->NumVertices() &&
+            page.usedIndices + numIndices <= page.indexBuffer->NumIndices())
+        {
+            return i;
+        }
+    }
+
+    // Meshes larger than a page get a page of their own size.
+    Page page;
+    page.vertexBuffer = CreateShared<VertexBuffer>();
+    page.vertexBuffer->Define(BufferUsage::STATIC, std::max(m_PageVertices, numVertices), m_Layout);
+    page.indexBuffer = CreateShared<IndexBuffer>();
+    page.indexBuffer->Define(BufferUsage::STATIC, std::max(m_PageIndices, numIndices));
+    page.usedVertices = 0;
+    page.usedIndices = 0;
+    m_Pages.push_back(std::move(page));
+
+    return m_Pages.size() - 1;
+}
+
+void GeometryPool::BindPage(const SharedPtr<ShaderProgram>& program, const Page& page)
+{
+    program->Bind();
+
+    // Each page has its own cached vertex array.
+    Graphics::BindGeometry(page.vertexBuffer.Get(), page.indexBuffer.Get(), page.vertexBuffer->Attributes());
+}
+
+} // namespace Pt
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+
+#include "Object/Ptr.hpp"
+#include "Graphics/Vertex.hpp"
+#include "Graphics/IndexBuffer.hpp"
+#include "Graphics/ShaderProgram.hpp"
+#include "Graphics/VertexBuffer.hpp"
+
+namespace Pt {
+
+#define DEFAULT_GEOMETRY_PAGE_VERTICES (64 * 1024)
+#define DEFAULT_GEOMETRY_PAGE_INDICES (192 * 1024)
+
+/// Location of a mesh inside a GeometryPool.
+struct GeometryRange
+{
+    /// Page holding the mesh buffers.
+    unsigned page;
+    unsigned firstIndex;
+    /// 0 if the mesh could not be added.
+    unsigned numIndices;
+    /// Added to every index of the mesh.
+    int baseVertex;
+
+    bool IsValid() const { return numIndices != 0; }
+};
+
+/// Meshes of one vertex layout packed into a few large buffers.
+/// Meshes in the same page draw without rebinding, and queued draws go out as one multi-draw per page.
+/// Meshes can not be removed one by one, the pool is meant for static geometry. Not thread-safe.
+class GeometryPool : public RefCounted
+{
+public:
+    GeometryPool(const VertexLayout& layout, size_t pageVertices = DEFAULT_GEOMETRY_PAGE_VERTICES,
+        size_t pageIndices = DEFAULT_GEOMETRY_PAGE_INDICES);
+
+    /// Copy a mesh into the pool. Indices are relative to the first vertex of the mesh.
+    GeometryRange Add(size_t numVertices, const void* vertices, size_t numIndices, const unsigned* indices);
+    /// Draw one mesh now. Uniforms such as U_MODEL are left to the caller.
+    void Draw(const SharedPtr<ShaderProgram>& program, const GeometryRange& range);
+    /// Record a mesh for Flush().
+    void Queue(const GeometryRange& range);
+    /// Draw queued meshes with one call per page. They share the uniforms, so suit geometry already in world space.
+    void Flush(const SharedPtr<ShaderProgram>& program);
+    /// Release all pages. Ranges returned before become invalid.
+    void Clear();
+
+    const VertexLayout& Layout() const { return m_Layout; }
+    size_t NumPages() const { return m_Pages.size(); }
+private:
+    struct Page
+    {
+        SharedPtr<VertexBuffer> vertexBuffer;
+        SharedPtr<IndexBuffer> indexBuffer;
+        size_t usedVertices;
+        size_t usedIndices;
+        /// Draws queued for Flush().
+        std::vector<int> counts;
+        std::vector<unsigned> firsts;
+        std::vector<int> baseVertices;
+    };
+
+    /// Return index of a page with room for the mesh, creating one if needed.
+    size_t FindPage(size_t numVertices, size_t numIndices);
+    void BindPage(const SharedPtr<ShaderProgram>& program, const Page& page);
+
+    VertexLayout m_Layout;
+    size_t m_PageVertices;
+    size_t m_PageIndices;
+    std::vector<Page> m_Pages;
+};
+
+} // namespace Pt
\ No newline at end of file
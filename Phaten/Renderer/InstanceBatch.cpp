@@ -0,0 +1,65 @@
+#include "InstanceBatch.hpp"
+
+#include "Graphics/Graphics.hpp"
+
+namespace Pt {
+
+static const size_t MIN_INSTANCE_BUFFER_SIZE = 64;
+
+static_assert(sizeof(InstanceData) == 20 * sizeof(float), "Instance data must match the instance vertex layout");
+
+InstanceBatch::InstanceBatch(const SharedPtr<VertexBuffer>& vertexBuffer, const SharedPtr<IndexBuffer>& indexBuffer) :
+    m_VertexBuffer(vertexBuffer),
+    m_IndexBuffer(indexBuffer)
+{
+}
+
+void InstanceBatch::Add(const Matrix4& model, const Vector4& params)
+{
+    m_Instances.push_back(InstanceData{ model, params });
+}
+
+void InstanceBatch::Draw(const SharedPtr<ShaderProgram>& program)
+{
+    if (m_Instances.empty())
+    {
+        return;
+    }
+
+    if (!m_InstanceBuffer || m_InstanceBuffer->NumVertices() < m_Instances.size())
+    {
+        size_t numVertices = MIN_INSTANCE_BUFFER_SIZE;
+        if (m_InstanceBuffer)
+        {
+            numVertices = m_InstanceBuffer->NumVertices();
+        }
+        while (numVertices < m_Instances.size())
+        {
+            numVertices *= 2;
+        }
+
+        m_InstanceBuffer = CreateShared<VertexBuffer>();
+        m_InstanceBuffer->Define(BufferUsage::DYNAMIC, numVertices,
+            VertexLayout{
+                {VertexElementType::FLOAT4, VertexElementSemantic::INSTANCE_MATRIX0}, // 5
+                {VertexElementType::FLOAT4, VertexElementSemantic::INSTANCE_MATRIX1}, // 6
+                {VertexElementType::FLOAT4, VertexElementSemantic::INSTANCE_MATRIX2}, // 7
+                {VertexElementType::FLOAT4, VertexElementSemantic::INSTANCE_MATRIX3}, // 8
+                {VertexElementType::FLOAT4, VertexElementSemantic::INSTANCE_PARAMS},  // 9
+            }
+        );
+        m_InstanceBuffer->SetPerInstance(true);
+    }
+    m_InstanceBuffer->SetData(0, m_Instances.size(), m_Instances.data(), true);
+
+    program->Bind();
+
+    // Both buffers take the program mask, each enables its own attributes only.
+    Graphics::BindGeometry(m_VertexBuffer.Get(), m_IndexBuffer.Get(), program->Attributes(), m_InstanceBuffer.Get());
+
+    Graphics::DrawIndexedInstanced(PrimitiveType::TRIANGLES, 0, m_IndexBuffer->NumIndices(), m_Instances.size());
+
+    m_Instances.clear();
+}
+
+} // namespace Pt
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+#include "Object/Ptr.hpp"
+#include "Math/Matrix.hpp"
+#include "Math/Vector.hpp"
+#include "Graphics/IndexBuffer.hpp"
+#include "Graphics/ShaderProgram.hpp"
+#include "Graphics/VertexBuffer.hpp"
+
+namespace Pt {
+
+/// Per-instance vertex data, read as aInstanceModel and aInstanceParams.
+struct InstanceData
+{
+    Matrix4 model;
+    /// Free for the shader, Basic.glsl uses it as a color tint.
+    Vector4 params;
+};
+
+/// Collects transforms of one mesh during a frame and draws them with a single instanced call.
+/// The program must be compiled with INSTANCED. Not thread-safe.
+class InstanceBatch : public RefCounted
+{
+public:
+    InstanceBatch(const SharedPtr<VertexBuffer>& vertexBuffer, const SharedPtr<IndexBuffer>& indexBuffer);
+
+    void Add(const Matrix4& model, const Vector4& params = Vector4::ONE);
+    void Clear() { m_Instances.clear(); }
+    /// Upload the instances, draw them all and clear the batch.
+    void Draw(const SharedPtr<ShaderProgram>& program);
+
+    size_t NumInstances() const { return m_Instances.size(); }
+private:
+    SharedPtr<VertexBuffer> m_VertexBuffer;
+    SharedPtr<IndexBuffer> m_IndexBuffer;
+    /// Per-instance buffer, grown by doubling and refilled every draw.
+    SharedPtr<VertexBuffer> m_InstanceBuffer;
+    std::vector<InstanceData> m_Instances;
+};
+
+} // namespace Pt
\ No newline at end of file
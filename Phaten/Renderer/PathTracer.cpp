@@ -0,0 +1,244 @@
+#include "PathTracer.hpp"
+
+#include <algorithm>
+
+#include "Thread/JobSystem.hpp"
+
+namespace Pt {
+
+static const unsigned TILE_SIZE = 16;
+static const unsigned DEFAULT_MAX_BOUNCES = 4;
+/// Bounces before russian roulette may terminate a path.
+static const unsigned MIN_BOUNCES = 2;
+static const float RAY_OFFSET = 0.0001f;
+/// Pixel block covered by one primary ray packet.
+static const unsigned PACKET_WIDTH = RayPacketN::SIZE / 2;
+static const unsigned PACKET_HEIGHT = 2;
+
+/// Small per-pixel random generator (PCG).
+class TraceRandom
+{
+public:
+    TraceRandom() :
+        m_State(0)
+    {
+    }
+
+    TraceRandom(unsigned pixel, unsigned sample) :
+        m_State(0)
+    {
+        Next();
+        m_State += (static_cast<uint64_t>(pixel) << 32) | sample;
+        Next();
+    }
+
+    /// Return uniform float in [0, 1).
+    float Float()
+    {
+        return (Next() >> 8) * (1.0f / 16777216.0f);
+    }
+private:
+    uint32_t Next()
+    {
+        uint64_t old = m_State;
+        m_State = old * 6364136223846793005ull + 1442695040888963407ull;
+        uint32_t xorShifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = static_cast<uint32_t>(old >> 59u);
+        return (xorShifted >> rot) | (xorShifted << ((32 - rot) & 31));
+    }
+
+    uint64_t m_State;
+};
+
+/// Cosine weighted direction in the hemisphere around normal.
+static Vector3 SampleHemisphere(const Vector3& normal, TraceRandom& random)
+{
+    float r1 = random.Float();
+    float r2 = random.Float();
+    float phi = M_2_PI * r1;
+    float r = sqrtf(r2);
+
+    Vector3 tangent = ::Abs(normal.x) > 0.9f ? Vector3::Y : Vector3::X;
+    tangent = Normalize(Cross(tangent, normal));
+    Vector3 bitangent = Cross(normal, tangent);
+
+    return Normalize(tangent * (cosf(phi) * r) + bitangent * (sinf(phi) * r) + normal * sqrtf(1.0f - r2));
+}
+
+/// Estimate radiance arriving along a ray whose first intersection is already known.
+static Vector3 TracePath(const TraceScene& scene, Ray ray, TraceHit hit, bool found, unsigned maxBounces, TraceRandom& random)
+{
+    Vector3 radiance = Vector3::ZERO;
+    Vector3 throughput = Vector3::ONE;
+
+    for (unsigned bounce = 0; bounce <= maxBounces; ++bounce)
+    {
+        if (bounce)
+            found = scene.Intersect(ray, hit);
+        if (!found)
+        {
+            radiance += throughput * scene.SkyColor();
+            break;
+        }
+
+        const TraceMaterial& material = scene.TriangleMaterial(hit.triangle);
+        radiance += throughput * material.emission;
+        throughput = throughput * material.albedo;
+
+        if (bounce >= MIN_BOUNCES)
+        {
+            float survival = std::min(std::max(throughput.x, std::max(throughput.y, throughput.z)), 0.95f);
+            if (random.Float() >= survival)
+                break;
+            throughput *= 1.0f / survival;
+        }
+
+        Vector3 normal = Dot(hit.normal, ray.direction) > 0.0f ? -hit.normal : hit.normal;
+        ray.origin = ray.At(hit.distance) + normal * RAY_OFFSET;
+        ray.direction = SampleHemisphere(normal, random);
+    }
+
+    return radiance;
+}
+
+PathTracer::PathTracer(const IntV2& size) :
+    m_Size(0, 0),
+    m_TilesX(0),
+    m_TilesY(0),
+    m_MaxBounces(DEFAULT_MAX_BOUNCES),
+    m_SampleCount(0),
+    m_InverseViewProj(Matrix4::IDENTITY)
+{
+    SetSize(size);
+}
+
+void PathTracer::SetScene(const SharedPtr<TraceScene>& scene)
+{
+    m_Scene = scene;
+    Reset();
+}
+
+void PathTracer::SetCamera(const Camera& camera)
+{
+    Matrix4 inverseViewProj = (camera.GetProjection() * camera.GetView()).Inverse();
+    if (inverseViewProj != m_InverseViewProj)
+    {
+        m_InverseViewProj = inverseViewProj;
+        Reset();
+    }
+}
+
+void PathTracer::SetSize(const IntV2& size)
+{
+    m_Size = IntV2(std::max(size.x, 1), std::max(size.y, 1));
+    m_TilesX = (m_Size.x + TILE_SIZE - 1) / TILE_SIZE;
+    m_TilesY = (m_Size.y + TILE_SIZE - 1) / TILE_SIZE;
+    m_Accumulation.resize(m_Size.x * m_Size.y);
+    m_Output.resize(m_Size.x * m_Size.y * 4);
+    Reset();
+}
+
+void PathTracer::Reset()
+{
+    std::fill(m_Accumulation.begin(), m_Accumulation.end(), Vector3::ZERO);
+    std::fill(m_Output.begin(), m_Output.end(), 0.0f);
+    m_SampleCount = 0;
+}
+
+void PathTracer::Render()
+{
+    if (!m_Scene)
+        return;
+    if (m_Scene->IsDirty())
+        m_Scene->Build();
+
+    unsigned numTiles = m_TilesX * m_TilesY;
+    auto renderTiles = [this](size_t begin, size_t end)
+    {
+        for (size_t tile = begin; tile < end; ++tile)
+            RenderTile(static_cast<unsigned>(tile));
+    };
+
+    JobSystem* jobSystem = Object::Subsystem<JobSystem>();
+    if (!jobSystem)
+    {
+        PT_TAG_INFO("PathTracer", "No job system registered, creating one for tracing");
+        m_JobSystem = CreateScoped<JobSystem>();
+        jobSystem = m_JobSystem.Get();
+    }
+
+    // One job per tile, idle threads steal tiles so uneven tiles do not stall a thread.
+    jobSystem->ParallelFor(0, numTiles, 1, renderTiles);
+
+    ++m_SampleCount;
+}
+
+void PathTracer::RenderTile(unsigned tile)
+{
+    unsigned startX = (tile % m_TilesX) * TILE_SIZE;
+    unsigned startY = (tile / m_TilesX) * TILE_SIZE;
+    unsigned endX = std::min(startX + TILE_SIZE, static_cast<unsigned>(m_Size.x));
+    unsigned endY = std::min(startY + TILE_SIZE, static_cast<unsigned>(m_Size.y));
+    float invSamples = 1.0f / (m_SampleCount + 1);
+
+    // Primary rays of a small pixel block are coherent and traced as one packet.
+    for (unsigned blockY = startY; blockY < endY; blockY += PACKET_HEIGHT)
+    {
+        for (unsigned blockX = startX; blockX < endX; blockX += PACKET_WIDTH)
+        {
+            Ray rays[RayPacketN::SIZE];
+            TraceRandom randoms[RayPacketN::SIZE];
+            unsigned pixels[RayPacketN::SIZE];
+            unsigned count = 0;
+
+            for (unsigned y = blockY; y < std::min(blockY + PACKET_HEIGHT, endY); ++y)
+            {
+                for (unsigned x = blockX; x < std::min(blockX + PACKET_WIDTH, endX); ++x)
+                {
+                    unsigned pixel = y * m_Size.x + x;
+                    TraceRandom& random = randoms[count];
+                    random = TraceRandom(pixel, m_SampleCount);
+
+                    float ndcX = 2.0f * (x + random.Float()) / m_Size.x - 1.0f;
+                    float ndcY = 2.0f * (y + random.Float()) / m_Size.y - 1.0f;
+                    rays[count] = CameraRay(ndcX, ndcY);
+                    pixels[count] = pixel;
+                    ++count;
+                }
+            }
+
+            RayPacketN packet;
+            packet.Set(rays, count);
+            m_Scene->Intersect(packet);
+
+            for (unsigned i = 0; i < count; ++i)
+            {
+                bool found = packet.Hit(i);
+                TraceHit hit;
+                hit.distance = packet.distance.Lane(i);
+                hit.triangle = found ? packet.triangle[i] : 0;
+                hit.normal = found ? m_Scene->TriangleNormal(hit.triangle) : Vector3::ZERO;
+                Vector3 radiance = TracePath(*m_Scene, rays[i], hit, found, m_MaxBounces, randoms[i]);
+
+                Vector3& sum = m_Accumulation[pixels[i]];
+                sum += radiance;
+                float* output = &m_Output[pixels[i] * 4];
+                output[0] = sum.x * invSamples;
+                output[1] = sum.y * invSamples;
+                output[2] = sum.z * invSamples;
+                output[3] = 1.0f;
+            }
+        }
+    }
+}
+
+Ray PathTracer::CameraRay(float x, float y) const
+{
+    Vector4 near = m_InverseViewProj * Vector4(x, y, -1.0f, 1.0f);
+    Vector4 far = m_InverseViewProj * Vector4(x, y, 1.0f, 1.0f);
+    Vector3 nearPoint = Vector3(near) * (1.0f / near.w);
+    Vector3 farPoint = Vector3(far) * (1.0f / far.w);
+    return Ray(nearPoint, farPoint - nearPoint);
+}
+
+} // namespace Pt
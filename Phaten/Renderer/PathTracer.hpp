@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+
+#include "Object/Ptr.hpp"
+#include "Math/IntVector.hpp"
+#include "Math/Matrix.hpp"
+#include "Math/Ray.hpp"
+#include "Math/Vector.hpp"
+#include "Thread/JobSystem.hpp"
+
+#include "Camera.hpp"
+#include "RayPacket.hpp"
+#include "TraceScene.hpp"
+
+namespace Pt {
+
+/// Progressive CPU path tracer. Does not require a graphics context.
+class PathTracer : public RefCounted
+{
+public:
+    PathTracer(const IntV2& size);
+
+    /// Set scene to trace.
+    void SetScene(const SharedPtr<TraceScene>& scene);
+    /// Copy camera matrices. Accumulation is reset if the camera moved.
+    void SetCamera(const Camera& camera);
+    /// Resize the output and reset accumulation.
+    void SetSize(const IntV2& size);
+    /// Set maximum path length.
+    void SetMaxBounces(unsigned bounces) { m_MaxBounces = bounces; }
+
+    /// Clear accumulated samples.
+    void Reset();
+    /// Trace one sample per pixel and accumulate it into the output. Tiles are traced on the registered job system.
+    /// If there is none, e.g. when rendering headless, the tracer creates and owns one.
+    void Render();
+
+    /// Get averaged RGBA32F pixels, rows bottom to top. Suitable for Texture::SetData.
+    const float* Data() const { return m_Output.data(); }
+    const IntV2& Size() const { return m_Size; }
+    unsigned SampleCount() const { return m_SampleCount; }
+private:
+    /// Trace and accumulate all pixels of one tile.
+    void RenderTile(unsigned tile);
+    /// Generate primary ray through a point in normalized device coordinates.
+    Ray CameraRay(float x, float y) const;
+
+    IntV2 m_Size;
+    unsigned m_TilesX;
+    unsigned m_TilesY;
+    unsigned m_MaxBounces;
+    unsigned m_SampleCount;
+
+    SharedPtr<TraceScene> m_Scene;
+    Matrix4 m_InverseViewProj;
+    /// Created by Render() when no job system is registered.
+    ScopedPtr<JobSystem> m_JobSystem;
+
+    /// Radiance sum per pixel.
+    std::vector<Vector3> m_Accumulation;
+    /// Averaged radiance per pixel.
+    std::vector<float> m_Output;
+};
+
+} // namespace Pt
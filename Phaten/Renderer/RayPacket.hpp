@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Math/Ray.hpp"
+#include "Math/SIMD.hpp"
+#include "Math/VectorSoA.hpp"
+
+namespace Pt {
+
+/// Packet of coherent rays traced together, one ray per lane of T (Float4 or Float8).
+template <typename T>
+struct RayPacket
+{
+    static constexpr unsigned SIZE = T::SIZE;
+
+    Vector3SoA<T> origin;
+    /// Normalized directions.
+    Vector3SoA<T> direction;
+    /// Max distance on input, closest hit distance on output. Negative disables the lane.
+    T distance;
+    /// Hit triangle per lane, UINT32_MAX if none.
+    unsigned triangle[SIZE];
+
+    /// Fill lanes from rays. Lanes past count are disabled.
+    void Set(const Ray* rays, unsigned count, float maxDistance = M_MAX_FLOAT)
+    {
+        float data[7][SIZE];
+        for (unsigned i = 0; i < SIZE; ++i)
+        {
+            const Ray& ray = rays[i < count ? i : 0];
+            data[0][i] = ray.origin.x;
+            data[1][i] = ray.origin.y;
+            data[2][i] = ray.origin.z;
+            data[3][i] = ray.direction.x;
+            data[4][i] = ray.direction.y;
+            data[5][i] = ray.direction.z;
+            data[6][i] = i < count ? maxDistance : -1.0f;
+            triangle[i] = UINT32_MAX;
+        }
+
+        origin = Vector3SoA<T>(T::Load(data[0]), T::Load(data[1]), T::Load(data[2]));
+        direction = Vector3SoA<T>(T::Load(data[3]), T::Load(data[4]), T::Load(data[5]));
+        distance = T::Load(data[6]);
+    }
+
+    /// Return true if the lane hit a triangle.
+    bool Hit(unsigned lane) const { return triangle[lane] != UINT32_MAX; }
+};
+
+using RayPacket4 = RayPacket<Float4>;
+using RayPacket8 = RayPacket<Float8>;
+using RayPacketN = RayPacket<FloatN>;
+
+} // namespace Pt
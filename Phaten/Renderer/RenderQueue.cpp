@@ -0,0 +1,147 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+
+#include "IO/Assert.hpp"
+#include "Object/Object.hpp"
+#include "Graphics/Graphics.hpp"
+#include "Graphics/IndexBuffer.hpp"
+#include "Graphics/ShaderProgram.hpp"
+#include "Graphics/Texture.hpp"
+#include "Graphics/VertexBuffer.hpp"
+
+namespace Pt {
+
+/// Bits of each sort key field, from the most significant.
+static const unsigned PASS_BITS = 8;
+static const unsigned PROGRAM_BITS = 14;
+static const unsigned TEXTURE_BITS = 14;
+static const unsigned BUFFER_BITS = 12;
+static const unsigned DEPTH_BITS = 16;
+
+static_assert(PASS_BITS + PROGRAM_BITS + TEXTURE_BITS + BUFFER_BITS + DEPTH_BITS == 64, "Sort key fields must fill 64 bits");
+
+/// Keep the low bits of a value. Equal handles get equal fields, collisions only cost sorting quality.
+static uint64_t KeyField(uint64_t value, unsigned bits)
+{
+    return value & ((uint64_t(1) << bits) - 1);
+}
+
+void RenderCommandList::Add(const RenderCommand& command)
+{
+    PT_ASSERT_MSG(command.program && command.vertexBuffer, "Render command needs a program and a vertex buffer");
+    m_Commands.push_back(command);
+    m_SortKeys.push_back(SortKey(command));
+}
+
+void RenderCommandList::Clear()
+{
+    m_Commands.clear();
+    m_SortKeys.clear();
+}
+
+uint64_t RenderCommandList::SortKey(const RenderCommand& command)
+{
+    uint64_t textures = 0;
+    for (const Texture* texture : command.textures)
+    {
+        textures = textures * 31 + (texture ? texture->GLHandle() : 0);
+    }
+
+    uint64_t buffers = command.vertexBuffer->GLHandle();
+    if (command.indexBuffer)
+    {
+        buffers = buffers * 31 + command.indexBuffer->GLHandle();
+    }
+
+    float depth = std::clamp(command.depth, 0.0f, 1.0f);
+    uint64_t depthBits = static_cast<uint64_t>(depth * ((1 << DEPTH_BITS) - 1));
+
+    uint64_t key = command.pass;
+    key = (key << PROGRAM_BITS) | KeyField(command.program->GLHandle(), PROGRAM_BITS);
+    key = (key << TEXTURE_BITS) | KeyField(textures, TEXTURE_BITS);
+    key = (key << BUFFER_BITS) | KeyField(buffers, BUFFER_BITS);
+    key = (key << DEPTH_BITS) | depthBits;
+    return key;
+}
+
+void RenderQueue::Submit(RenderCommandList& list)
+{
+    const std::vector<RenderCommand>& commands = list.Commands();
+    const std::vector<uint64_t>& keys = list.SortKeys();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        uint32_t offset = static_cast<uint32_t>(m_Commands.size());
+        m_Commands.insert(m_Commands.end(), commands.begin(), commands.end());
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            m_SortItems.push_back(SortItem{ keys[i], offset + static_cast<uint32_t>(i) });
+        }
+    }
+    list.Clear();
+}
+
+void RenderQueue::Execute()
+{
+    // Take the submitted commands, so Submit() from other threads does not touch the vectors being drawn.
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Commands.swap(m_ExecuteCommands);
+        m_SortItems.swap(m_ExecuteSortItems);
+    }
+
+    // Index breaks ties, so equal keys run in submission order.
+    std::sort(m_ExecuteSortItems.begin(), m_ExecuteSortItems.end());
+
+    Graphics* graphics = Object::Subsystem<Graphics>();
+    SharedPtr<ShaderProgram> program;
+    for (const SortItem& item : m_ExecuteSortItems)
+    {
+        const RenderCommand& command = m_ExecuteCommands[item.index];
+
+        if (command.program != program.Get())
+        {
+            program = command.program;
+            program->Bind();
+        }
+
+        graphics->SetUniform(program, PresetUniform::U_MODEL, command.model);
+
+        for (size_t unit = 0; unit < MAX_COMMAND_TEXTURES; ++unit)
+        {
+            if (command.textures[unit])
+            {
+                command.textures[unit]->Bind(unit);
+            }
+        }
+
+        Graphics::BindGeometry(command.vertexBuffer, command.indexBuffer, command.vertexBuffer->Attributes());
+        if (command.indexBuffer)
+        {
+            Graphics::DrawIndexed(command.type, command.first, command.count);
+        }
+        else
+        {
+            Graphics::Draw(command.type, command.first, command.count);
+        }
+    }
+
+    // Keep the memory for the next frame.
+    m_ExecuteCommands.clear();
+    m_ExecuteSortItems.clear();
+}
+
+void RenderQueue::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Commands.clear();
+    m_SortItems.clear();
+}
+
+size_t RenderQueue::Size() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Commands.size();
+}
+
+} // namespace Pt
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "Math/Matrix.hpp"
+#include "Graphics/GraphicsDefs.hpp"
+
+namespace Pt {
+
+class IndexBuffer;
+class ShaderProgram;
+class Texture;
+class VertexBuffer;
+
+static const size_t MAX_COMMAND_TEXTURES = 4;
+
+/// Draw call recorded for later execution. Referenced objects must stay alive until the queue is executed.
+struct RenderCommand
+{
+    ShaderProgram* program;
+    VertexBuffer* vertexBuffer;
+    /// Null for non-indexed draws.
+    IndexBuffer* indexBuffer;
+    /// Textures by unit. Units left null keep their binding.
+    Texture* textures[MAX_COMMAND_TEXTURES];
+    /// Set as U_MODEL if the program uses it.
+    Matrix4 model;
+    PrimitiveType type;
+    unsigned first;
+    unsigned count;
+    /// Passes are executed in increasing order.
+    uint8_t pass;
+    /// Distance from the camera normalized to [0, 1]. Orders draws sharing the same state front to back.
+    float depth;
+};
+
+/// Commands recorded by one thread. Not thread-safe, use one list per thread or job.
+class RenderCommandList
+{
+public:
+    /// Record a command and compute its sort key.
+    void Add(const RenderCommand& command);
+    /// Remove all commands, keeping the memory.
+    void Clear();
+
+    size_t Size() const { return m_Commands.size(); }
+    const std::vector<RenderCommand>& Commands() const { return m_Commands; }
+    const std::vector<uint64_t>& SortKeys() const { return m_SortKeys; }
+
+    /// Return key ordering commands by pass, program, textures, buffers and depth.
+    static uint64_t SortKey(const RenderCommand& command);
+private:
+    std::vector<RenderCommand> m_Commands;
+    std::vector<uint64_t> m_SortKeys;
+};
+
+/// Collects command lists and executes them sorted, so commands sharing a program, textures or buffers run together.
+class RenderQueue
+{
+public:
+    /// Append the commands of a list and clear it. Thread-safe.
+    void Submit(RenderCommandList& list);
+    /// Sort and execute commands submitted so far. Must be called on the graphics thread.
+    /// Commands submitted meanwhile are kept for the next call.
+    void Execute();
+    /// Drop submitted commands.
+    void Clear();
+
+    /// Return number of submitted commands. Thread-safe.
+    size_t Size() const;
+private:
+    /// Sort key and index of a submitted command.
+    struct SortItem
+    {
+        uint64_t key;
+        uint32_t index;
+
+        bool operator < (const SortItem& rhs) const { return key != rhs.key ? key < rhs.key : index < rhs.index; }
+    };
+
+    /// Submitted commands, guarded by the mutex.
+    std::vector<RenderCommand> m_Commands;
+    std::vector<SortItem> m_SortItems;
+    /// Commands taken by Execute(), swapped with the submitted ones to reuse memory.
+    std::vector<RenderCommand> m_ExecuteCommands;
+    std::vector<SortItem> m_ExecuteSortItems;
+    mutable std::mutex m_Mutex;
+};
+
+} // namespace Pt
\ No newline at end of file
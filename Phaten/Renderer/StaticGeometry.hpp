@@ -6,8 +6,37 @@
 #include "Graphics/VertexBuffer.hpp"
 #include "Resource/Mesh/BasicMesh.hpp"
 
+#include "GeometryPool.hpp"
+#include "InstanceBatch.hpp"
+#include "RenderQueue.hpp"
+
 namespace Pt {
 
+/// Return an indexed command drawing all indices of the buffers.
+inline RenderCommand MakeRenderCommand(const SharedPtr<ShaderProgram>& program, const SharedPtr<VertexBuffer>& vertexBuffer,
+    const SharedPtr<IndexBuffer>& indexBuffer, const Matrix4& model)
+{
+    RenderCommand command{};
+    command.program = program.Get();
+    command.vertexBuffer = vertexBuffer.Get();
+    command.indexBuffer = indexBuffer.Get();
+    command.model = model;
+    command.type = PrimitiveType::TRIANGLES;
+    command.first = 0;
+    command.count = static_cast<unsigned>(indexBuffer->NumIndices());
+    return command;
+}
+
+/// Position, normal, texcoord layout of the Plane and Cube meshes.
+inline VertexLayout MeshVertexLayout()
+{
+    return VertexLayout{
+        {VertexElementType::FLOAT3, VertexElementSemantic::POSITION}, // 0
+        {VertexElementType::FLOAT3, VertexElementSemantic::NORMAL},   // 1
+        {VertexElementType::FLOAT2, VertexElementSemantic::TEX_COORD}, // 4
+    };
+}
+
 class Plane
 {   
 public:
@@ -20,11 +49,7 @@ public:
 
         m_VertexBuffer = CreateShared<VertexBuffer>();
         m_VertexBuffer->Define(BufferUsage::STATIC, PlaneMesh::VertexCount,
-            VertexLayout{
-                {VertexElementType::FLOAT3, VertexElementSemantic::POSITION}, // 0
-                {VertexElementType::FLOAT3, VertexElementSemantic::NORMAL},   // 1
-                {VertexElementType::FLOAT2, VertexElementSemantic::TEX_COORD}, // 4
-            },
+            MeshVertexLayout(),
             PlaneMesh::Vertices
         );
 
@@ -37,12 +62,30 @@ public:
         program->Bind();
         m_Graphics->SetUniform(program, PresetUniform::U_MODEL, m_Model);
 
-        m_VertexBuffer->Bind(m_VertexBuffer->Attributes());
-        m_IndexBuffer->Bind();
+        m_Graphics->BindGeometry(m_VertexBuffer.Get(), m_IndexBuffer.Get(), m_VertexBuffer->Attributes());
 
         m_Graphics->DrawIndexed(PrimitiveType::TRIANGLES, 0, m_IndexBuffer->NumIndices());
     }
 
+    /// Return a command drawing like Draw(), to record in a RenderCommandList.
+    RenderCommand Command(const SharedPtr<ShaderProgram>& program) const
+    {
+        return MakeRenderCommand(program, m_VertexBuffer, m_IndexBuffer, m_Model);
+    }
+
+    /// Return a batch drawing many copies of this mesh in one call.
+    SharedPtr<InstanceBatch> CreateBatch() const
+    {
+        return CreateShared<InstanceBatch>(m_VertexBuffer, m_IndexBuffer);
+    }
+
+    /// Copy the plane mesh into a pool with the same position, normal, texcoord layout.
+    static GeometryRange AddTo(GeometryPool& pool)
+    {
+        PT_ASSERT_MSG(pool.Layout() == MeshVertexLayout(), "Geometry pool layout does not match the plane mesh");
+        return pool.Add(PlaneMesh::VertexCount, PlaneMesh::Vertices, PlaneMesh::IndexCount, PlaneMesh::Indices);
+    }
+
     SharedPtr<VertexBuffer> m_VertexBuffer;
     SharedPtr<IndexBuffer> m_IndexBuffer;
 
@@ -75,8 +118,7 @@ public:
 
     void Draw(size_t count)
     {
-        m_VertexBuffer->Bind(m_VertexBuffer->Attributes());
-        m_IndexBuffer->Bind();
+        m_Graphics->BindGeometry(m_VertexBuffer.Get(), m_IndexBuffer.Get(), m_VertexBuffer->Attributes());
 
         m_Graphics->DrawIndexed(PrimitiveType::TRIANGLES, 0, count);
     }
@@ -113,8 +155,7 @@ public:
     {
         program->Bind();
 
-        m_VertexBuffer->Bind(m_VertexBuffer->Attributes());
-        m_IndexBuffer->Bind();
+        m_Graphics->BindGeometry(m_VertexBuffer.Get(), m_IndexBuffer.Get(), m_VertexBuffer->Attributes());
 
         m_Graphics->DrawIndexed(PrimitiveType::TRIANGLES, 0, m_IndexBuffer->NumIndices());
     }
@@ -137,11 +178,7 @@ public:
 
         m_VertexBuffer = CreateShared<VertexBuffer>();
         m_VertexBuffer->Define(BufferUsage::STATIC, CubeMesh::VertexCount,
-            VertexLayout{
-                {VertexElementType::FLOAT3, VertexElementSemantic::POSITION}, // 0
-                {VertexElementType::FLOAT3, VertexElementSemantic::NORMAL},   // 1
-                {VertexElementType::FLOAT2, VertexElementSemantic::TEX_COORD}, // 4
-            },
+            MeshVertexLayout(),
             CubeMesh::Vertices
         );
 
@@ -154,12 +191,30 @@ public:
         program->Bind();
         m_Graphics->SetUniform(program, PresetUniform::U_MODEL, m_Model);
 
-        m_VertexBuffer->Bind(m_VertexBuffer->Attributes());
-        m_IndexBuffer->Bind();
+        m_Graphics->BindGeometry(m_VertexBuffer.Get(), m_IndexBuffer.Get(), m_VertexBuffer->Attributes());
 
         m_Graphics->DrawIndexed(PrimitiveType::TRIANGLES, 0, m_IndexBuffer->NumIndices());
     }
 
+    /// Return a command drawing like Draw(), to record in a RenderCommandList.
+    RenderCommand Command(const SharedPtr<ShaderProgram>& program) const
+    {
+        return MakeRenderCommand(program, m_VertexBuffer, m_IndexBuffer, m_Model);
+    }
+
+    /// Return a batch drawing many copies of this mesh in one call.
+    SharedPtr<InstanceBatch> CreateBatch() const
+    {
+        return CreateShared<InstanceBatch>(m_VertexBuffer, m_IndexBuffer);
+    }
+
+    /// Copy the cube mesh into a pool with the same position, normal, texcoord layout.
+    static GeometryRange AddTo(GeometryPool& pool)
+    {
+        PT_ASSERT_MSG(pool.Layout() == MeshVertexLayout(), "Geometry pool layout does not match the cube mesh");
+        return pool.Add(CubeMesh::VertexCount, CubeMesh::Vertices, CubeMesh::IndexCount, CubeMesh::Indices);
+    }
+
     SharedPtr<VertexBuffer> m_VertexBuffer;
     SharedPtr<IndexBuffer> m_IndexBuffer;
 
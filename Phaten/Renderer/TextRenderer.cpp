@@ -113,6 +113,8 @@ void TextRenderer::Initialize()
 
     /// Allocate vertices buffer.
     m_Vertices = new Vector3[MAX_TEXT_SIZE * 4];
+    // Changing text must not reallocate every frame.
+    m_LastText.reserve(MAX_TEXT_SIZE);
 
     // Setup index buffer.
     unsigned*  indices = new unsigned[MAX_TEXT_SIZE * 6];
@@ -0,0 +1,88 @@
+#include "TraceScene.hpp"
+
+#include "IO/Assert.hpp"
+
+namespace Pt {
+
+TraceScene::TraceScene() :
+    m_SkyColor(Vector3::ZERO),
+    m_Dirty(false)
+{
+}
+
+unsigned TraceScene::AddMaterial(const TraceMaterial& material)
+{
+    m_Materials.push_back(material);
+    return static_cast<unsigned>(m_Materials.size() - 1);
+}
+
+void TraceScene::AddTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, unsigned material)
+{
+    PT_ASSERT_MSG(material < m_Materials.size(), "Invalid trace material index: ", material);
+    m_Positions.push_back(v0);
+    m_Positions.push_back(v1);
+    m_Positions.push_back(v2);
+    m_TriangleMaterials.push_back(material);
+    m_Dirty = true;
+}
+
+void TraceScene::AddMesh(const float* vertices, size_t vertexStride, const unsigned* indices, size_t indexCount, const Matrix4& transform, unsigned material)
+{
+    if (!vertices || !indices)
+        return;
+
+    m_Positions.reserve(m_Positions.size() + indexCount);
+    for (size_t i = 0; i + 2 < indexCount; i += 3)
+    {
+        Vector3 v[3];
+        for (size_t j = 0; j < 3; ++j)
+        {
+            const float* position = vertices + indices[i + j] * vertexStride;
+            v[j] = transform * Vector4(position[0], position[1], position[2], 1.0f);
+        }
+        AddTriangle(v[0], v[1], v[2], material);
+    }
+}
+
+void TraceScene::Clear()
+{
+    m_Positions.clear();
+    m_TriangleMaterials.clear();
+    m_Materials.clear();
+    m_BVH.Clear();
+    m_Dirty = false;
+}
+
+void TraceScene::Build()
+{
+    m_BVH.Build(m_Positions.data(), m_TriangleMaterials.size());
+    m_Dirty = false;
+}
+
+bool TraceScene::Intersect(const Ray& ray, TraceHit& hit, float maxDistance) const
+{
+    PT_ASSERT_MSG(!m_Dirty, "Trace scene must be built before tracing");
+
+    BVHHit bvhHit;
+    if (!m_BVH.Intersect(ray, bvhHit, maxDistance))
+        return false;
+
+    hit.distance = bvhHit.distance;
+    hit.triangle = bvhHit.triangle;
+    hit.normal = TriangleNormal(bvhHit.triangle);
+    return true;
+}
+
+void TraceScene::Intersect(RayPacketN& packet) const
+{
+    PT_ASSERT_MSG(!m_Dirty, "Trace scene must be built before tracing");
+    m_BVH.Intersect(packet);
+}
+
+Vector3 TraceScene::TriangleNormal(unsigned triangle) const
+{
+    const Vector3* v = &m_Positions[triangle * 3];
+    return Normalize(Cross(v[1] - v[0], v[2] - v[0]));
+}
+
+} // namespace Pt
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+
+#include "Object/Ptr.hpp"
+#include "Math/Matrix.hpp"
+#include "Math/Ray.hpp"
+#include "Math/Vector.hpp"
+
+#include "BVH.hpp"
+
+namespace Pt {
+
+/// Surface description of traced triangles.
+struct TraceMaterial
+{
+    /// Diffuse reflectance.
+    Vector3 albedo;
+    /// Emitted radiance.
+    Vector3 emission;
+};
+
+/// Closest intersection found along a ray.
+struct TraceHit
+{
+    /// Distance along the ray.
+    float distance;
+    /// Index of the hit triangle.
+    unsigned triangle;
+    /// Geometric normal of the hit triangle.
+    Vector3 normal;
+};
+
+/// Triangle soup traced by the CPU path tracer.
+class TraceScene : public RefCounted
+{
+public:
+    TraceScene();
+
+    /// Add a material and return its index.
+    unsigned AddMaterial(const TraceMaterial& material);
+    /// Add a triangle in world space.
+    void AddTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, unsigned material);
+    /// Add an indexed mesh. Position is read from the first 3 floats of each vertex, stride is in floats.
+    void AddMesh(const float* vertices, size_t vertexStride, const unsigned* indices, size_t indexCount, const Matrix4& transform, unsigned material);
+    /// Remove all triangles and materials.
+    void Clear();
+
+    /// Rebuild the BVH after triangles changed.
+    void Build();
+    /// Return true if triangles changed since the last build.
+    bool IsDirty() const { return m_Dirty; }
+
+    /// Find the closest hit within max distance. The scene must be built.
+    bool Intersect(const Ray& ray, TraceHit& hit, float maxDistance = M_MAX_FLOAT) const;
+    /// Find the closest hits of a packet of coherent rays. The scene must be built.
+    void Intersect(RayPacketN& packet) const;
+
+    /// Set radiance returned by rays which escape the scene.
+    void SetSkyColor(const Vector3& color) { m_SkyColor = color; }
+    const Vector3& SkyColor() const { return m_SkyColor; }
+
+    /// Get material of a triangle.
+    const TraceMaterial& TriangleMaterial(unsigned triangle) const { return m_Materials[m_TriangleMaterials[triangle]]; }
+    /// Get normalized geometric normal of a triangle.
+    Vector3 TriangleNormal(unsigned triangle) const;
+    size_t NumTriangles() const { return m_TriangleMaterials.size(); }
+private:
+    /// Triangle vertices, 3 per triangle.
+    std::vector<Vector3> m_Positions;
+    /// Material index per triangle.
+    std::vector<unsigned> m_TriangleMaterials;
+    std::vector<TraceMaterial> m_Materials;
+    BVH m_BVH;
+    Vector3 m_SkyColor;
+    bool m_Dirty;
+};
+
+} // namespace Pt
@@ -3,6 +3,7 @@
 #include <stb_image.h>
 
 #include "IO/Logger.hpp"
+#include "IO/Stream.hpp"
 #include "Graphics/GraphicsDefs.hpp"
 
 namespace Pt {
@@ -16,6 +17,37 @@ static const ImageFormat PixelByteToImageFormat[] =
     ImageFormat::RGBA8
 };
 
+/// Decode an image from the position of a stream. Streams in memory are decoded in place, others are read first.
+static unsigned char* DecodeImage(Stream& source, IntV2& size, int& channels)
+{
+    const unsigned char* data = source.Data();
+    size_t bytes = source.Size() - source.Position();
+    std::string buffer;
+    if (data)
+    {
+        data += source.Position();
+        source.Seek(source.Size());
+    }
+    else
+    {
+        buffer = source.ReadAll();
+        data = reinterpret_cast<const unsigned char*>(buffer.data());
+        bytes = buffer.size();
+    }
+
+    if (!bytes || bytes > INT32_MAX)
+        return nullptr;
+
+    return stbi_load_from_memory(data, static_cast<int>(bytes), &size.x, &size.y, &channels, 0);
+}
+
+/// Map the file and decode it.
+static unsigned char* DecodeImage(std::string_view path, IntV2& size, int& channels)
+{
+    MappedFileStream file(path);
+    return file.IsOpen() ? DecodeImage(file, size, channels) : nullptr;
+}
+
 Image::Image() :
     m_Size(IntV2::ZERO),
     m_Format(ImageFormat::NONE),
@@ -34,26 +66,35 @@ void Image::RegisterObject()
     Object::RegisterFactory<Image>();
 }
 
-void Image::Load(std::string_view path)
+bool Image::Load(std::string_view path)
+{
+    SetName(path);
+    return Resource::Load();
+}
+
+bool Image::BeginLoad()
 {
     Release();
 
-    stbi_set_flip_vertically_on_load(true);
+    // Per thread flag, other workers may be decoding at the same time.
+    stbi_set_flip_vertically_on_load_thread(true);
 
     int channels = 0;
+    std::string_view path = Name();
 
-    m_Data = stbi_load(path.data(), &m_Size.x, &m_Size.y, &channels, 0);
+    m_Data = DecodeImage(path, m_Size, channels);
 
     if (!m_Data || (m_Size.x | m_Size.y | channels) == 0)
     {
         PT_LOG_WARN("Failed to load image: ", path);
         Release();
-        return;
+        return false;
     }
 
     m_PixelBytes = channels;
     m_Format = PixelByteToImageFormat[channels];
     PT_LOG_INFO("Loaded image: ", path, " ", m_Size.x, "x", m_Size.y, " pixel bytes: ", (int)m_PixelBytes);
+    return true;
 }
 
 void Image::Release()
@@ -79,21 +120,22 @@ CubeMapImage::~CubeMapImage()
     Release();
 }
 
-void CubeMapImage::Load(std::string_view path)
+bool CubeMapImage::BeginLoad()
 {
     Release();
 
-    stbi_set_flip_vertically_on_load(false);
+    stbi_set_flip_vertically_on_load_thread(false);
 
     int channels = 0;
+    std::string_view path = Name();
 
-    unsigned char* image = stbi_load(path.data(), &m_Size.x, &m_Size.y, &channels, 0);
+    unsigned char* image = DecodeImage(path, m_Size, channels);
 
     if (!image || (m_Size.x | m_Size.y | channels) == 0)
     {
         PT_LOG_WARN("Failed to load image: ", path);
         Release();
-        return;
+        return false;
     }
     
     int size = m_Size.x / 4;
@@ -145,6 +187,7 @@ void CubeMapImage::Load(std::string_view path)
     m_PixelBytes = channels;
     m_Format = PixelByteToImageFormat[channels];
     PT_LOG_INFO("Loaded cubemap image: ", path, " ", m_Size.x, "x", m_Size.y, " pixel bytes: ", (int)m_PixelBytes);
+    return true;
 }
 
 void CubeMapImage::Release()
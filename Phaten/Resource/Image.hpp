@@ -2,14 +2,15 @@
 
 #include <string_view>
 
-#include "Object/Object.hpp"
 #include "Math/IntVector.hpp"
 #include "Graphics/GraphicsDefs.hpp"
 
+#include "Resource.hpp"
+
 namespace Pt {
 
-/// Reusable image class.
-class Image : public Object
+/// Reusable image class. Decoding in BeginLoad() is safe on worker threads.
+class Image : public Resource
 {
     OBJECT(Image);
 public:
@@ -18,7 +19,11 @@ public:
 
     static void RegisterObject();
 
-    virtual void Load(std::string_view path);
+    using Resource::Load;
+    /// Load an image file on the calling thread.
+    bool Load(std::string_view path);
+    /// Decode the image file given by Name().
+    virtual bool BeginLoad() override;
 
     virtual const IntV2& Size() const { return m_Size; }
     ImageFormat Format() const { return m_Format; }
@@ -40,7 +45,8 @@ public:
     CubeMapImage();
     virtual ~CubeMapImage() override;
 
-    virtual void Load(std::string_view path) override;
+    /// Decode a cross layout cubemap image file given by Name().
+    virtual bool BeginLoad() override;
 private:
     virtual void Release() override;
 };
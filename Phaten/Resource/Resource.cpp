@@ -4,6 +4,12 @@
 
 namespace Pt {
 
+Resource::Resource() :
+    Object(RefCountPolicy::THREAD_SAFE),
+    m_AsyncLoadState(AsyncLoadState::DONE)
+{
+}
+
 bool Resource::BeginLoad()
 {
     PT_ASSERT_MSG(false, "Do not use base BeginLoad");
@@ -30,7 +36,7 @@ bool Resource::Load()
 void Resource::SetName(std::string_view newName)
 {
     m_Name = std::string(newName);
-    m_NameHash = StringHash(newName.data());
+    m_NameHash = StringHash::Register(newName);
 }
 
 } // namespace Pt
\ No newline at end of file
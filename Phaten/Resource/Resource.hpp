@@ -1,27 +1,53 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <string_view>
 
+#include "Object/Object.hpp"
 #include "IO/StringHash.hpp"
 
 namespace Pt {
 
-/// Base class for resources
-class Resource
+/// Background loading progress of a resource.
+enum class AsyncLoadState
+{
+    /// Not being loaded in the background.
+    DONE = 0,
+    /// Waiting for a worker thread.
+    QUEUED,
+    /// BeginLoad() is running on a worker thread.
+    LOADING,
+    /// BeginLoad() finished, waiting for EndLoad() on the main thread.
+    SUCCESS,
+    /// BeginLoad() failed, waiting for the main thread to report it.
+    FAILED,
+};
+
+/// Base class for resources. Loading is split so that the expensive part can run on a worker thread.
+/// Reference counts are thread-safe, so resources can be handed between loader threads and the main thread.
+class Resource : public Object
 {
 public:
+    Resource();
+
+    /// Read and decode the file given by Name(). May run on a worker thread, so it must not use the graphics API or object factories.
     virtual bool BeginLoad() = 0;
+    /// Finish loading on the main thread, e.g. create GPU objects.
     virtual bool EndLoad();
 
+    /// Load synchronously on the calling thread.
     bool Load();
     void SetName(std::string_view newName);
+    void SetAsyncLoadState(AsyncLoadState state) { m_AsyncLoadState.store(state, std::memory_order_release); }
 
     std::string_view Name() const { return m_Name; }
     StringHash NameHash() const { return m_NameHash; }
+    AsyncLoadState GetAsyncLoadState() const { return m_AsyncLoadState.load(std::memory_order_acquire); }
 private:
     std::string m_Name;
     StringHash m_NameHash;
+    std::atomic<AsyncLoadState> m_AsyncLoadState;
 };
 
 } // namespace Pt
\ No newline at end of file
@@ -1,5 +1,148 @@
 #include "ResourceLoader.hpp"
 
+#include <chrono>
+#include <thread>
+
+#include "IO/Logger.hpp"
+#include "Thread/JobSystem.hpp"
+
+// Resources created on loader workers take RefCounts from the shared allocator.
+#ifndef PT_CONCURRENT_ALLOCATOR
+    #error "ResourceLoader loads on worker threads and requires PT_CONCURRENT_ALLOCATOR"
+#endif
+
 namespace Pt {
 
+namespace detail {
+
+void ResourceLoadCommandQueue::Push(ResourceLoadCommand* command)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Commands.push_back(command);
+}
+
+ResourceLoadCommand* ResourceLoadCommandQueue::TryPop()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Commands.empty())
+        return nullptr;
+
+    ResourceLoadCommand* command = m_Commands.front();
+    m_Commands.pop_front();
+    return command;
+}
+
+bool ResourceLoadCommandQueue::IsEmpty() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Commands.empty();
+}
+
+} // namespace detail
+
+ResourceLoader::ResourceLoader() :
+    m_NumPending(0)
+{
+    Object::RegisterSubsystem(this);
+}
+
+ResourceLoader::~ResourceLoader()
+{
+    // Jobs still reference the completion queue, so wait for all of them before going away.
+    while (NumPending())
+    {
+        if (detail::ResourceLoadCommand* command = m_Completed.TryPop())
+        {
+            command->resource->SetAsyncLoadState(AsyncLoadState::DONE);
+            delete command;
+            m_NumPending.fetch_sub(1, std::memory_order_release);
+            continue;
+        }
+
+        JobSystem* jobSystem = Object::Subsystem<JobSystem>();
+        if (!jobSystem || !jobSystem->RunPendingJob())
+            std::this_thread::yield();
+    }
+
+    Object::RemoveSubsystem(this);
+}
+
+void ResourceLoader::LoadAsync(Resource* resource, Callback callback)
+{
+    if (!resource)
+        return;
+
+    if (resource->GetAsyncLoadState() != AsyncLoadState::DONE)
+    {
+        PT_TAG_WARN("Resource", "Already loading ", resource->Name());
+        return;
+    }
+
+    // The command owns the reference, so the last release and any GPU cleanup in the destructor happen on the main thread.
+    auto* command = new detail::ResourceLoadCommand{ SharedPtr<Resource>(resource), std::move(callback), false };
+    resource->SetAsyncLoadState(AsyncLoadState::QUEUED);
+    m_NumPending.fetch_add(1, std::memory_order_relaxed);
+
+    detail::ResourceLoadCommandQueue* completed = &m_Completed;
+    if (JobSystem* jobSystem = Object::Subsystem<JobSystem>())
+        jobSystem->Submit([command, completed]() { BeginLoad(command, completed); });
+    else
+        BeginLoad(command, completed);
+}
+
+unsigned ResourceLoader::Update(float budgetMs)
+{
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::duration<float, std::milli>(budgetMs);
+
+    unsigned numFinished = 0;
+    while (detail::ResourceLoadCommand* command = m_Completed.TryPop())
+    {
+        EndLoad(command);
+        ++numFinished;
+
+        if (std::chrono::steady_clock::now() - start >= budget)
+            break;
+    }
+
+    return numFinished;
+}
+
+void ResourceLoader::WaitAll()
+{
+    JobSystem* jobSystem = Object::Subsystem<JobSystem>();
+    while (NumPending())
+    {
+        if (detail::ResourceLoadCommand* command = m_Completed.TryPop())
+            EndLoad(command);
+        else if (!jobSystem || !jobSystem->RunPendingJob())
+            std::this_thread::yield();
+    }
+}
+
+void ResourceLoader::BeginLoad(detail::ResourceLoadCommand* command, detail::ResourceLoadCommandQueue* completed)
+{
+    Resource* resource = command->resource.Get();
+    resource->SetAsyncLoadState(AsyncLoadState::LOADING);
+    command->success = resource->BeginLoad();
+    resource->SetAsyncLoadState(command->success ? AsyncLoadState::SUCCESS : AsyncLoadState::FAILED);
+    completed->Push(command);
+}
+
+void ResourceLoader::EndLoad(detail::ResourceLoadCommand* command)
+{
+    Resource* resource = command->resource.Get();
+    bool success = command->success && resource->EndLoad();
+    if (!success)
+        PT_TAG_ERROR("Resource", "Failed to load ", resource->Name());
+
+    resource->SetAsyncLoadState(AsyncLoadState::DONE);
+    if (command->callback)
+        command->callback(resource, success);
+
+    // Releases the strong reference on the main thread.
+    delete command;
+    m_NumPending.fetch_sub(1, std::memory_order_release);
+}
+
 } // namespace Pt
\ No newline at end of file
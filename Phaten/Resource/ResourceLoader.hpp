@@ -1,28 +1,74 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "Object/Object.hpp"
+#include "Object/Ptr.hpp"
+
+#include "Resource.hpp"
+
 namespace Pt {
 
 namespace detail {
 
+/// Resource in flight between a worker thread and the main thread.
 struct ResourceLoadCommand
 {
-
+    /// Strong reference, released on the main thread.
+    SharedPtr<Resource> resource;
+    std::function<void(Resource*, bool)> callback;
+    /// Result of BeginLoad().
+    bool success;
 };
 
+/// Commands whose BeginLoad() has finished. Pushed by workers, popped by the main thread.
 class ResourceLoadCommandQueue
 {
+public:
+    void Push(ResourceLoadCommand* command);
+    /// Return null if empty.
+    ResourceLoadCommand* TryPop();
 
+    bool IsEmpty() const;
+private:
+    std::deque<ResourceLoadCommand*> m_Commands;
+    mutable std::mutex m_Mutex;
 };
 
 } // namespace detail
 
-class ResourceLoader
+/// Loads resources in the background. BeginLoad() runs on the job system, EndLoad() and callbacks run in Update().
+class ResourceLoader : public Object
 {
+    OBJECT(ResourceLoader);
 public:
+    /// Called on the main thread with the resource and whether loading succeeded.
+    using Callback = std::function<void(Resource*, bool)>;
+
     ResourceLoader();
+    /// Wait for running jobs and drop finished ones without calling EndLoad().
     ~ResourceLoader();
+
+    /// Queue a resource for background loading. The resource is kept alive until its callback has run.
+    void LoadAsync(Resource* resource, Callback callback = nullptr);
+    /// Finish loaded resources until the time budget in milliseconds is used up. At least one is finished per call. Return number finished.
+    unsigned Update(float budgetMs = 2.0f);
+    /// Finish all queued resources, blocking until done.
+    void WaitAll();
+
+    /// Return number of resources not yet finished by Update().
+    unsigned NumPending() const { return m_NumPending.load(std::memory_order_acquire); }
 private:
+    /// Worker side of a load.
+    static void BeginLoad(detail::ResourceLoadCommand* command, detail::ResourceLoadCommandQueue* completed);
+    /// Main thread side of a load. Deletes the command.
+    void EndLoad(detail::ResourceLoadCommand* command);
 
+    detail::ResourceLoadCommandQueue m_Completed;
+    std::atomic<unsigned> m_NumPending;
 };
 
 } // namespace Pt
\ No newline at end of file
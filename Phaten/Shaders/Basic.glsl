@@ -5,6 +5,12 @@
 layout (location = 0) in vec3 aPosition;
 layout (location = 1) in vec3 aNormal;
 layout (location = 4) in vec2 aTexCoord;
+#if defined(INSTANCED)
+// Per instance, a mat4 takes locations 5 to 8.
+layout (location = 5) in mat4 aInstanceModel;
+layout (location = 9) in vec4 aInstanceParams;
+out vec4 vParams;
+#endif
 out vec3 vPosition;
 out vec3 vNormal;
 out vec2 vTexCoord;
@@ -17,12 +23,20 @@ layout (location = 0) out vec4 FragColor;
 in vec3 vPosition;
 in vec3 vNormal;
 in vec2 vTexCoord;
+#if defined(INSTANCED)
+in vec4 vParams;
+#endif
 
 #endif
 
 void vert()
 {
+#if defined(INSTANCED)
+    vec4 pos = aInstanceModel * vec4(aPosition, 1.0);
+    vParams = aInstanceParams;
+#else
     vec4 pos = uModel * vec4(aPosition, 1.0);
+#endif
     vPosition = pos.xyz;
     vNormal = aNormal;
     vTexCoord = aTexCoord;
@@ -34,5 +48,9 @@ void frag()
     vec4 color = texture(uTexture1, vTexCoord);
     if (color.a < 0.1)
         discard;
+#if defined(INSTANCED)
+    // Params are used as a color tint.
+    color *= vParams;
+#endif
     FragColor = vec4(color.rgb, 1.0);
 }
\ No newline at end of file
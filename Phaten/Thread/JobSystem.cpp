@@ -0,0 +1,268 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+
+#include "IO/Logger.hpp"
+#include "ThreadUtils.hpp"
+
+namespace Pt {
+
+static const unsigned NO_THREAD_INDEX = UINT32_MAX;
+
+/// Job system and queue index owned by the calling thread.
+static thread_local JobSystem* sThreadJobSystem = nullptr;
+static thread_local unsigned sThreadIndex = NO_THREAD_INDEX;
+
+TaskGroup::TaskGroup() :
+    TaskGroup(Object::Subsystem<JobSystem>())
+{
+}
+
+TaskGroup::TaskGroup(JobSystem* jobSystem) :
+    m_JobSystem(jobSystem),
+    m_Pending(1),
+    m_HasContinuation(false),
+    m_Open(true)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    Wait();
+}
+
+void TaskGroup::Run(std::function<void()> function)
+{
+    if (m_JobSystem)
+        m_JobSystem->Submit(std::move(function), this);
+    else
+        function();
+}
+
+void TaskGroup::SetContinuation(std::function<void()> function)
+{
+    if (!m_HasContinuation.load(std::memory_order_relaxed))
+        m_Pending.fetch_add(1, std::memory_order_relaxed);
+    m_Continuation = std::move(function);
+    m_HasContinuation.store(true, std::memory_order_release);
+}
+
+void TaskGroup::Wait()
+{
+    if (m_Open)
+    {
+        m_Open = false;
+        Finish();
+    }
+
+    while (m_Pending.load(std::memory_order_acquire))
+    {
+        if (!m_JobSystem || !m_JobSystem->RunPendingJob())
+            std::this_thread::yield();
+    }
+
+    m_Pending.store(1, std::memory_order_relaxed);
+    m_Open = true;
+}
+
+void TaskGroup::Finish()
+{
+    // Read before releasing the reference, the group may be destroyed once the count reaches zero.
+    bool hasContinuation = m_HasContinuation.load(std::memory_order_acquire);
+    if (m_Pending.fetch_sub(1, std::memory_order_acq_rel) != 2 || !hasContinuation)
+        return;
+
+    // Only the continuation reference is left.
+    m_HasContinuation.store(false, std::memory_order_relaxed);
+    std::function<void()> continuation = std::move(m_Continuation);
+    m_Continuation = nullptr;
+    if (m_JobSystem)
+        m_JobSystem->Queue(new Job{ std::move(continuation), this });
+    else
+    {
+        continuation();
+        Finish();
+    }
+}
+
+JobSystem::JobSystem(unsigned numThreads) :
+    m_NumShared(0),
+    m_NumQueued(0),
+    m_NumSleeping(0),
+    m_ShouldExit(false)
+{
+    Object::RegisterSubsystem(this);
+
+    if (!numThreads)
+        numThreads = std::max(CPUCount(), 1u);
+    for (unsigned i = 0; i < numThreads; ++i)
+        m_Queues.emplace_back(new WorkStealingQueue());
+
+    sThreadJobSystem = this;
+    sThreadIndex = 0;
+
+    m_Workers.reserve(numThreads - 1);
+    for (unsigned i = 1; i < numThreads; ++i)
+        m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+
+    PT_TAG_INFO("JobSystem", "Created job system with ", numThreads, " threads");
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_ShouldExit.store(true);
+    }
+    m_SleepCondition.notify_all();
+    for (std::thread& worker : m_Workers)
+        worker.join();
+    m_Workers.clear();
+
+    // Jobs left behind still run so that their groups finish.
+    while (Job* job = FindJob())
+        Execute(job);
+
+    if (sThreadJobSystem == this)
+    {
+        sThreadJobSystem = nullptr;
+        sThreadIndex = NO_THREAD_INDEX;
+    }
+
+    Object::RemoveSubsystem(this);
+    PT_TAG_INFO("JobSystem", "Exited job system");
+}
+
+void JobSystem::Submit(std::function<void()> function, TaskGroup* group)
+{
+    if (group)
+        group->m_Pending.fetch_add(1, std::memory_order_relaxed);
+    Queue(new Job{ std::move(function), group });
+}
+
+void JobSystem::ParallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& function)
+{
+    if (begin >= end)
+        return;
+    grainSize = std::max(grainSize, size_t(1));
+    if (end - begin <= grainSize || m_Workers.empty())
+    {
+        function(begin, end);
+        return;
+    }
+
+    TaskGroup group(this);
+    for (size_t start = begin + grainSize; start < end; start += grainSize)
+    {
+        size_t stop = std::min(start + grainSize, end);
+        group.Run([&function, start, stop]() { function(start, stop); });
+    }
+    // The calling thread takes the first range and then helps with the rest.
+    function(begin, begin + grainSize);
+    group.Wait();
+}
+
+bool JobSystem::RunPendingJob()
+{
+    Job* job = FindJob();
+    if (!job)
+        return false;
+    Execute(job);
+    return true;
+}
+
+bool JobSystem::IsWorkerThread() const
+{
+    return sThreadJobSystem == this;
+}
+
+void JobSystem::Queue(Job* job)
+{
+    if (m_Workers.empty())
+    {
+        Execute(job);
+        return;
+    }
+
+    if (sThreadJobSystem == this)
+        m_Queues[sThreadIndex]->Push(job);
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_SharedQueueMutex);
+        m_SharedQueue.push_back(job);
+        m_NumShared.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Pairs with the sleeping count update in WorkerLoop so that a wakeup cannot be missed.
+    m_NumQueued.fetch_add(1);
+    if (m_NumSleeping.load())
+    {
+        { std::lock_guard<std::mutex> lock(m_SleepMutex); }
+        m_SleepCondition.notify_one();
+    }
+}
+
+Job* JobSystem::FindJob()
+{
+    unsigned self = sThreadJobSystem == this ? sThreadIndex : NO_THREAD_INDEX;
+    Job* job = nullptr;
+
+    if (self != NO_THREAD_INDEX)
+        job = m_Queues[self]->Pop();
+
+    if (!job && m_NumShared.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(m_SharedQueueMutex);
+        if (!m_SharedQueue.empty())
+        {
+            job = m_SharedQueue.front();
+            m_SharedQueue.pop_front();
+            m_NumShared.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Steal starting from the next thread so thieves spread over the victims.
+    unsigned numQueues = static_cast<unsigned>(m_Queues.size());
+    unsigned start = self != NO_THREAD_INDEX ? self + 1 : 0;
+    for (unsigned i = 0; !job && i < numQueues; ++i)
+    {
+        unsigned victim = (start + i) % numQueues;
+        if (victim != self)
+            job = m_Queues[victim]->Steal();
+    }
+
+    if (job)
+        m_NumQueued.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+}
+
+void JobSystem::Execute(Job* job)
+{
+    job->function();
+    TaskGroup* group = job->group;
+    delete job;
+    if (group)
+        group->Finish();
+}
+
+void JobSystem::WorkerLoop(unsigned index)
+{
+    sThreadJobSystem = this;
+    sThreadIndex = index;
+
+    while (!m_ShouldExit.load(std::memory_order_relaxed))
+    {
+        if (Job* job = FindJob())
+        {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_NumSleeping.fetch_add(1);
+        m_SleepCondition.wait(lock, [this]() { return m_NumQueued.load() > 0 || m_ShouldExit.load(); });
+        m_NumSleeping.fetch_sub(1);
+    }
+}
+
+} // namespace Pt
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Object/Object.hpp"
+
+#include "WorkStealingQueue.hpp"
+
+namespace Pt {
+
+class JobSystem;
+class TaskGroup;
+
+/// Unit of work queued in the job system.
+struct Job
+{
+    std::function<void()> function;
+    /// Group notified when the job finishes, may be null.
+    TaskGroup* group;
+};
+
+/// Jobs that are waited on together. The continuation is queued once all jobs have finished.
+class TaskGroup
+{
+public:
+    /// Use the registered job system, or run jobs immediately if there is none.
+    TaskGroup();
+    TaskGroup(JobSystem* jobSystem);
+    /// Wait for remaining jobs.
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator = (const TaskGroup&) = delete;
+
+    /// Queue a job in the group.
+    void Run(std::function<void()> function);
+    /// Set function to queue after all jobs finished. Must be set before Wait().
+    void SetContinuation(std::function<void()> function);
+    /// Execute queued jobs on the calling thread until the jobs and the continuation have finished. The group can be reused afterwards.
+    void Wait();
+
+    /// Return true if there is nothing left to wait for.
+    bool IsFinished() const { return m_Pending.load(std::memory_order_acquire) <= (m_Open ? 1u : 0u); }
+private:
+    friend class JobSystem;
+
+    /// Release one reference. Queue the continuation when only its reference is left.
+    void Finish();
+
+    JobSystem* m_JobSystem;
+    /// Unfinished jobs, the continuation and one reference until Wait() is called.
+    std::atomic<unsigned> m_Pending;
+    std::function<void()> m_Continuation;
+    std::atomic<bool> m_HasContinuation;
+    /// Wait() has not released the initial reference yet.
+    bool m_Open;
+};
+
+/// Work stealing scheduler. Each worker owns a Chase-Lev deque and steals from the others when it runs dry.
+class JobSystem : public Object
+{
+    OBJECT(JobSystem);
+public:
+    /// Start worker threads. Number of threads includes the creating thread, which executes jobs while waiting. 0 for CPUCount().
+    JobSystem(unsigned numThreads = 0);
+    ~JobSystem();
+
+    /// Queue a job. Without worker threads it runs immediately.
+    void Submit(std::function<void()> function, TaskGroup* group = nullptr);
+    /// Call function(begin, end) over ranges of at most grain size items in parallel and wait for all of them.
+    void ParallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& function);
+    /// Execute one queued job on the calling thread. Return false if none was found.
+    bool RunPendingJob();
+
+    /// Return number of threads executing jobs, including the creating thread.
+    unsigned NumThreads() const { return static_cast<unsigned>(m_Queues.size()); }
+    /// Return true if the calling thread is a worker or the creating thread.
+    bool IsWorkerThread() const;
+private:
+    friend class TaskGroup;
+
+    /// Queue a job without touching the group count. Without worker threads it runs immediately.
+    void Queue(Job* job);
+    /// Find a job from the own queue, the shared queue, or another thread.
+    Job* FindJob();
+    /// Run and delete a job.
+    void Execute(Job* job);
+    /// Worker thread loop.
+    void WorkerLoop(unsigned index);
+
+    /// Deque per thread. Index 0 belongs to the creating thread.
+    std::vector<std::unique_ptr<WorkStealingQueue>> m_Queues;
+    std::vector<std::thread> m_Workers;
+
+    /// Jobs submitted from threads outside the job system.
+    std::deque<Job*> m_SharedQueue;
+    std::mutex m_SharedQueueMutex;
+    std::atomic<unsigned> m_NumShared;
+
+    /// Queued jobs not yet taken by any thread. Briefly negative when a job is taken before it is counted.
+    std::atomic<int> m_NumQueued;
+    /// Workers waiting for jobs.
+    std::atomic<unsigned> m_NumSleeping;
+    std::mutex m_SleepMutex;
+    std::condition_variable m_SleepCondition;
+    std::atomic<bool> m_ShouldExit;
+};
+
+} // namespace Pt
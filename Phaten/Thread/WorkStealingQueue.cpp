@@ -0,0 +1,90 @@
+#include "WorkStealingQueue.hpp"
+
+namespace Pt {
+
+WorkStealingQueue::Buffer::Buffer(size_t capacity) :
+    mask(capacity - 1),
+    jobs(new std::atomic<Job*>[capacity])
+{
+}
+
+WorkStealingQueue::WorkStealingQueue(size_t capacity) :
+    m_Top(0),
+    m_Bottom(0)
+{
+    size_t size = 1;
+    while (size < capacity)
+        size <<= 1;
+    m_Buffers.emplace_back(new Buffer(size));
+    m_Buffer.store(m_Buffers.back().get(), std::memory_order_relaxed);
+}
+
+void WorkStealingQueue::Push(Job* job)
+{
+    int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+    int64_t top = m_Top.load(std::memory_order_acquire);
+    Buffer* buffer = m_Buffer.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(buffer->mask))
+        buffer = Grow(buffer, bottom, top);
+
+    buffer->Put(bottom, job);
+    m_Bottom.store(bottom + 1, std::memory_order_release);
+}
+
+Job* WorkStealingQueue::Pop()
+{
+    int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = m_Buffer.load(std::memory_order_relaxed);
+    // Sequentially consistent so the reservation is visible to thieves before top is read.
+    m_Bottom.exchange(bottom, std::memory_order_seq_cst);
+    int64_t top = m_Top.load(std::memory_order_seq_cst);
+
+    if (top > bottom)
+    {
+        // Empty
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = buffer->Get(bottom);
+    if (top == bottom)
+    {
+        // Last job, race against thieves.
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            job = nullptr;
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* WorkStealingQueue::Steal()
+{
+    int64_t top = m_Top.load(std::memory_order_seq_cst);
+    int64_t bottom = m_Bottom.load(std::memory_order_seq_cst);
+    if (top >= bottom)
+        return nullptr;
+
+    Buffer* buffer = m_Buffer.load(std::memory_order_acquire);
+    Job* job = buffer->Get(top);
+    if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+    return job;
+}
+
+bool WorkStealingQueue::IsEmpty() const
+{
+    return m_Top.load(std::memory_order_relaxed) >= m_Bottom.load(std::memory_order_relaxed);
+}
+
+WorkStealingQueue::Buffer* WorkStealingQueue::Grow(Buffer* buffer, int64_t bottom, int64_t top)
+{
+    Buffer* newBuffer = new Buffer((buffer->mask + 1) * 2);
+    for (int64_t i = top; i < bottom; ++i)
+        newBuffer->Put(i, buffer->Get(i));
+
+    m_Buffers.emplace_back(newBuffer);
+    m_Buffer.store(newBuffer, std::memory_order_release);
+    return newBuffer;
+}
+
+} // namespace Pt
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Pt {
+
+struct Job;
+
+/// Chase-Lev deque. The owner thread pushes and pops at the bottom, other threads steal from the top.
+class WorkStealingQueue
+{
+public:
+    WorkStealingQueue(size_t capacity = 256);
+
+    /// Add a job. Owner thread only. The queue grows when full.
+    void Push(Job* job);
+    /// Take the most recently pushed job. Owner thread only.
+    Job* Pop();
+    /// Take the oldest job. Any thread. Return null if empty or another thread won the race.
+    Job* Steal();
+
+    bool IsEmpty() const;
+private:
+    /// Circular array of jobs, capacity is a power of two.
+    struct Buffer
+    {
+        Buffer(size_t capacity);
+
+        Job* Get(int64_t index) const { return jobs[index & mask].load(std::memory_order_relaxed); }
+        void Put(int64_t index, Job* job) { jobs[index & mask].store(job, std::memory_order_relaxed); }
+
+        size_t mask;
+        std::unique_ptr<std::atomic<Job*>[]> jobs;
+    };
+
+    /// Copy live jobs into a buffer twice the size.
+    Buffer* Grow(Buffer* buffer, int64_t bottom, int64_t top);
+
+    /// Thieves and the owner touch different ends, keep them on separate cache lines.
+    alignas(64) std::atomic<int64_t> m_Top;
+    alignas(64) std::atomic<int64_t> m_Bottom;
+    std::atomic<Buffer*> m_Buffer;
+    /// All buffers including replaced ones, which thieves may still be reading.
+    std::vector<std::unique_ptr<Buffer>> m_Buffers;
+};
+
+} // namespace Pt
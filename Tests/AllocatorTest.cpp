@@ -0,0 +1,100 @@
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Object/Allocator.hpp"
+
+using namespace Pt;
+
+static const char* TEST_ALLOCATOR_NAME = "CrossThreadTest";
+static const size_t NUM_THREADS = 4;
+static const size_t NUM_ITERATIONS = 8000;
+/// Threads allocate up to this many nodes per turn, a random count so caches run empty and overflow.
+static const size_t MAX_ALLOCATIONS_PER_TURN = 128;
+/// Live nodes, thread caches and one bounded growth step fit well below this.
+static const size_t MAX_CAPACITY = 4096;
+
+struct Payload
+{
+    uint64_t data[4];
+};
+
+static size_t AllocatorCapacity()
+{
+    for (const AllocatorStats& stats : GetAllocatorStats())
+    {
+        if (stats.name == TEST_ALLOCATOR_NAME)
+            return stats.capacity;
+    }
+    return 0;
+}
+
+/// Threads take turns. Each allocates, frees half itself and hands the other half to the next thread to free.
+/// At most a few hundred nodes are live, so capacity must not follow the total number of allocations.
+static bool TestCrossThreadFreeCapacity()
+{
+    ConcurrentAllocator<Payload> allocator(DEFAULT_ALLOCATE_INITIAL_CAPACITY, TEST_ALLOCATOR_NAME);
+    std::vector<Payload*> inboxes[NUM_THREADS];
+    size_t numAllocations = 0;
+
+    // Turns keep the interleaving the same on any number of cores.
+    std::mutex mutex;
+    std::condition_variable turnChanged;
+    size_t turn = 0;
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < NUM_THREADS; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            std::minstd_rand random(static_cast<unsigned>(t + 1));
+            std::vector<Payload*> nodes;
+
+            for (size_t i = 0; i < NUM_ITERATIONS; ++i)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                turnChanged.wait(lock, [&]() { return turn % NUM_THREADS == t; });
+
+                size_t count = random() % (MAX_ALLOCATIONS_PER_TURN + 1);
+                for (size_t j = 0; j < count; ++j)
+                    nodes.push_back(allocator.Allocate());
+                numAllocations += count;
+
+                std::vector<Payload*>& next = inboxes[(t + 1) % NUM_THREADS];
+                next.insert(next.end(), nodes.begin() + count / 2, nodes.end());
+                nodes.resize(count / 2);
+                for (Payload* node : nodes)
+                    allocator.Free(node);
+                nodes.clear();
+
+                for (Payload* node : inboxes[t])
+                    allocator.Free(node);
+                inboxes[t].clear();
+
+                ++turn;
+                turnChanged.notify_all();
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (std::vector<Payload*>& inbox : inboxes)
+    {
+        for (Payload* node : inbox)
+            allocator.Free(node);
+    }
+
+    size_t capacity = AllocatorCapacity();
+    std::printf("Cross-thread free: capacity %zu after %zu allocations\n", capacity, numAllocations);
+    return capacity && capacity <= MAX_CAPACITY;
+}
+
+int main()
+{
+    bool success = TestCrossThreadFreeCapacity();
+    std::printf("%s\n", success ? "Passed" : "Failed");
+    return success ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "IO/StringHash.hpp"
+
+using namespace Pt;
+
+static const int NUM_NAMES = 500000;
+/// A good 32-bit hash gives about 29 collisions for 500k names, n^2 / 2^33.
+static const size_t MAX_COLLISIONS = 80;
+
+/// Hash sequentially numbered names and count the hashes that repeat.
+static size_t CountCollisions(const char* format)
+{
+    std::vector<unsigned> hashes;
+    hashes.reserve(NUM_NAMES);
+    char name[64];
+    for (int i = 0; i < NUM_NAMES; ++i)
+    {
+        std::snprintf(name, sizeof(name), format, i);
+        hashes.push_back(StringHash::Calculate(name));
+    }
+
+    std::sort(hashes.begin(), hashes.end());
+    size_t collisions = 0;
+    for (size_t i = 1; i < hashes.size(); ++i)
+    {
+        if (hashes[i] == hashes[i - 1])
+            ++collisions;
+    }
+    return collisions;
+}
+
+static bool TestSequentialNames()
+{
+    bool passed = true;
+    for (const char* format : {"name_%d", "Texture%d", "Mesh/Prop_%06d.obj", "u_Lights[%d].color", "%d"})
+    {
+        size_t collisions = CountCollisions(format);
+        std::printf("%-20s %zu collisions\n", format, collisions);
+        if (collisions > MAX_COLLISIONS)
+            passed = false;
+    }
+    return passed;
+}
+
+static bool TestKnownPairs()
+{
+    static_assert(StringHash("").ToHash() == 0, "Empty string must hash to zero");
+    static_assert("u_Model"_hash == StringHash("U_MODEL"), "Hash must ignore ASCII case");
+
+    return StringHash("name_1809") != StringHash("name_1884") &&
+        StringHash("Texture1900") != StringHash("Texture9200") &&
+        StringHash("Mesh/Prop_011973.obj") != StringHash("Mesh/Prop_055082.obj");
+}
+
+int main()
+{
+    bool success = TestKnownPairs();
+    if (!success)
+        std::printf("Known colliding names still collide\n");
+    success = TestSequentialNames() && success;
+    std::printf("%s\n", success ? "Passed" : "Failed");
+    return success ? 0 : 1;
+}